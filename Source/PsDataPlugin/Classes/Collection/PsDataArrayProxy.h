@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Collection/PsDataCollectionIndex.h"
+#include "Collection/PsDataQuery.h"
 #include "PsData.h"
 #include "PsDataCore.h"
 #include "PsDataEvent.h"
@@ -47,7 +49,7 @@ public:
 
 	FPsDataBaseArrayProxy(UPsData* InInstance, int32 Hash)
 		: Instance(InInstance)
-		, Property(GetProperty(InInstance, FDataReflection::GetFieldByHash(InInstance->GetClass(), Hash)))
+		, Property(GetProperty(InInstance, FDataReflection::GetFieldByHash(InInstance, Hash)))
 	{
 		check(IsValid());
 	}
@@ -106,29 +108,21 @@ public:
 		typename = typename TEnableIf<!bOtherConst>::Type>
 	int32 Add(typename FDataReflectionTools::TConstRef<T, false>::Type Element)
 	{
-		auto NewArray = Property->Get();
-		auto Index = NewArray.Add(Element);
-		Property->Set(NewArray, Instance.Get());
-
-		return Index;
+		return Property->AddElement(Element, Instance.Get());
 	}
 
 	template <bool bOtherConst = bConst,
 		typename = typename TEnableIf<!bOtherConst>::Type>
 	void Insert(typename FDataReflectionTools::TConstRef<T, false>::Type Element, int32 Index)
 	{
-		auto NewArray = Property->Get();
-		NewArray.Insert(Element, Index);
-		Property->Set(NewArray, Instance.Get());
+		Property->InsertElement(Element, Index, Instance.Get());
 	}
 
 	template <bool bOtherConst = bConst,
 		typename = typename TEnableIf<!bOtherConst>::Type>
 	void RemoveAt(int32 Index, bool bAllowShrinking = false)
 	{
-		auto NewArray = Property->Get();
-		NewArray.RemoveAt(Index, 1, bAllowShrinking);
-		Property->Set(NewArray, Instance.Get());
+		Property->RemoveElementAt(Index, Instance.Get(), bAllowShrinking);
 	}
 
 	template <bool bOtherConst = bConst,
@@ -141,10 +135,7 @@ public:
 			return INDEX_NONE;
 		}
 
-		auto NewArray = Property->Get();
-		NewArray.RemoveAt(Index, 1, bAllowShrinking);
-		Property->Set(NewArray, Instance.Get());
-
+		Property->RemoveElementAt(Index, Instance.Get(), bAllowShrinking);
 		return Index;
 	}
 
@@ -171,13 +162,9 @@ public:
 
 	template <bool bOtherConst = bConst,
 		typename = typename TEnableIf<!bOtherConst>::Type>
-	typename FDataReflectionTools::TConstRef<T, bConst>::Type Set(typename FDataReflectionTools::TConstRef<T, false>::Type Element, int32 Index)
+	typename FDataReflectionTools::TConstValue<T, bConst>::Type Set(typename FDataReflectionTools::TConstRef<T, false>::Type Element, int32 Index)
 	{
-		auto NewArray = Property->Get();
-		auto& OldElement = NewArray[Index];
-		NewArray[Index] = Element;
-		Property->Set(NewArray, Instance.Get());
-		return OldElement;
+		return Property->SetElement(Element, Index, Instance.Get());
 	}
 
 	template <bool bOtherConst = bConst,
@@ -226,6 +213,33 @@ public:
 		return nullptr;
 	}
 
+	template <typename V>
+	TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> FindByIndex(int32 FieldHash, const V& Value) const
+	{
+		TArray<UPsData*> Result;
+		if (const FPsDataFieldIndex* Index = FDataReflectionTools::FPsDataFriend::GetCollectionIndex(Instance.Get(), Property->GetField()).GetFieldIndex(FieldHash))
+		{
+			Index->Find(FPsDataIndexKey(Value), Result);
+		}
+		return CastIndexed(Result);
+	}
+
+	template <typename V>
+	TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> FindRangeByIndex(int32 FieldHash, const V& Min, const V& Max) const
+	{
+		TArray<UPsData*> Result;
+		if (const FPsDataFieldIndex* Index = FDataReflectionTools::FPsDataFriend::GetCollectionIndex(Instance.Get(), Property->GetField()).GetFieldIndex(FieldHash))
+		{
+			Index->FindRange(FPsDataIndexKey(Min), FPsDataIndexKey(Max), Result);
+		}
+		return CastIndexed(Result);
+	}
+
+	TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> Query(const FPsDataQuery& Query) const
+	{
+		return CastIndexed(Query.Execute(Property->Get()));
+	}
+
 	typename FDataReflectionTools::TConstRef<T, bConst>::Type Get(int32 Index) const
 	{
 		return Property->Get()[Index];
@@ -246,24 +260,24 @@ public:
 		return Property->Get().IsValidIndex(Index);
 	}
 
-	FPsDataBind Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const
+	FPsDataBind Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate, int32 Priority = 0) const
 	{
-		return Instance->BindInternal(Type, Delegate, Property->GetField());
+		return Instance->BindInternal(FName(*Type), Delegate, Property->GetField(), Priority);
 	}
 
-	FPsDataBind Bind(const FString& Type, const FPsDataDelegate& Delegate) const
+	FPsDataBind Bind(const FString& Type, const FPsDataDelegate& Delegate, int32 Priority = 0) const
 	{
-		return Instance->BindInternal(Type, Delegate, Property->GetField());
+		return Instance->BindInternal(FName(*Type), Delegate, Property->GetField(), Priority);
 	}
 
 	void Unbind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const
 	{
-		Instance->UnbindInternal(Type, Delegate, Property->GetField());
+		Instance->UnbindInternal(FName(*Type, FNAME_Find), Delegate, Property->GetField());
 	}
 
 	void Unbind(const FString& Type, const FPsDataDelegate& Delegate) const
 	{
-		Instance->UnbindInternal(Type, Delegate, Property->GetField());
+		Instance->UnbindInternal(FName(*Type, FNAME_Find), Delegate, Property->GetField());
 	}
 
 	typename FDataReflectionTools::TConstRef<T, bConst>::Type operator[](int32 Index) const
@@ -271,6 +285,18 @@ public:
 		return Property->Get()[Index];
 	}
 
+private:
+	static TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> CastIndexed(const TArray<UPsData*>& Data)
+	{
+		TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> Result;
+		Result.Reserve(Data.Num());
+		for (UPsData* Element : Data)
+		{
+			Result.Add(static_cast<typename FDataReflectionTools::TConstValue<T, bConst>::Type>(Element));
+		}
+		return Result;
+	}
+
 	/***********************************
 	 * TProxyIterator
 	 ***********************************/
@@ -0,0 +1,78 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "Collection/PsDataQuery.h"
+#include "PsData.h"
+
+#include "CoreMinimal.h"
+
+#include "PsDataBlueprintQuery.generated.h"
+
+class UPsDataBlueprintArrayProxy;
+class UPsDataBlueprintMapProxy;
+
+UCLASS(Blueprintable, BlueprintType)
+class PSDATAPLUGIN_API UPsDataBlueprintQuery : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+private:
+	FPsDataQuery Query;
+
+public:
+	/** Create query over elements of class */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	static UPsDataBlueprintQuery* CreateQuery(TSubclassOf<UPsData> Class);
+
+	/** Get query */
+	const FPsDataQuery& GetQuery() const;
+
+	/** Is valid */
+	UFUNCTION(BlueprintPure, meta = (Category = "PsData|Query"))
+	bool IsValid() const;
+
+	/** Where for int32 property */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	UPsDataBlueprintQuery* WhereInt(const FString& FieldName, EPsDataQueryOperator Operator, int32 Value);
+
+	/** Where for float property */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	UPsDataBlueprintQuery* WhereFloat(const FString& FieldName, EPsDataQueryOperator Operator, float Value);
+
+	/** Where for bool property */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	UPsDataBlueprintQuery* WhereBool(const FString& FieldName, EPsDataQueryOperator Operator, bool Value);
+
+	/** Where for string or name property */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	UPsDataBlueprintQuery* WhereString(const FString& FieldName, EPsDataQueryOperator Operator, const FString& Value);
+
+	/** Order by */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	UPsDataBlueprintQuery* OrderBy(const FString& FieldName, bool bDescending);
+
+	/** Limit */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	UPsDataBlueprintQuery* Limit(int32 Count);
+
+	/** Select property for projection */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	UPsDataBlueprintQuery* Select(const FString& FieldName);
+
+	/** Execute over array */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	TArray<UPsData*> ExecuteArray(UPsDataBlueprintArrayProxy* Proxy) const;
+
+	/** Execute over map */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	TArray<UPsData*> ExecuteMap(UPsDataBlueprintMapProxy* Proxy) const;
+
+	/** Values of selected property as strings */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	TArray<FString> ProjectToStrings(const TArray<UPsData*>& Data) const;
+
+	/** Values of selected property as floats */
+	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Query"))
+	TArray<float> ProjectToFloats(const TArray<UPsData*>& Data) const;
+};
@@ -0,0 +1,122 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "PsDataField.h"
+
+#include "CoreMinimal.h"
+
+class UPsData;
+
+/***********************************
+ * FPsDataIndexKey
+ ***********************************/
+
+/** Value of indexed property, numbers are compared as double */
+struct PSDATAPLUGIN_API FPsDataIndexKey
+{
+	bool bString;
+	double Number;
+	FString String;
+
+	FPsDataIndexKey();
+	FPsDataIndexKey(int32 Value);
+	FPsDataIndexKey(int64 Value);
+	FPsDataIndexKey(uint8 Value);
+	FPsDataIndexKey(float Value);
+	FPsDataIndexKey(bool Value);
+	FPsDataIndexKey(const FString& Value);
+	FPsDataIndexKey(const TCHAR* Value);
+	FPsDataIndexKey(const FName& Value);
+
+	/** Typed key reader of property */
+	typedef FPsDataIndexKey (*FReader)(UPsData* Data, const TSharedPtr<const FDataField>& Field);
+
+	/** Get key reader for property, nullptr for unsupported type */
+	static FReader GetReader(const TSharedPtr<const FDataField>& Field);
+
+	/** Read key from property of data, false for unsupported type */
+	static bool Read(UPsData* Data, const TSharedPtr<const FDataField>& Field, FPsDataIndexKey& OutKey);
+
+	bool operator==(const FPsDataIndexKey& Other) const;
+	bool operator<(const FPsDataIndexKey& Other) const;
+
+	friend uint32 GetTypeHash(const FPsDataIndexKey& Key)
+	{
+		return Key.bString ? GetTypeHash(Key.String) : GetTypeHash(Key.Number);
+	}
+};
+
+/***********************************
+ * FPsDataFieldIndex
+ ***********************************/
+
+/** Hash and ordered index of one property over all collection elements */
+struct PSDATAPLUGIN_API FPsDataFieldIndex
+{
+public:
+	FPsDataFieldIndex(const TSharedPtr<const FDataField>& InField);
+
+	const TSharedPtr<const FDataField>& GetField() const;
+
+	void Add(UPsData* Data);
+	void Remove(UPsData* Data);
+	void Update(UPsData* Data);
+
+	/** Replace indexed data with elements */
+	void Build(const TArray<UPsData*>& Elements);
+
+	void Find(const FPsDataIndexKey& Key, TArray<UPsData*>& OutData) const;
+	void FindRange(const FPsDataIndexKey& Min, const FPsDataIndexKey& Max, TArray<UPsData*>& OutData) const;
+
+private:
+	TSharedPtr<const FDataField> Field;
+
+	/** Key of every indexed data */
+	TMap<UPsData*, FPsDataIndexKey> Keys;
+
+	/** Data by key */
+	TMap<FPsDataIndexKey, TSet<UPsData*>> Hash;
+
+	/** Data sorted by key, rebuilt from Keys by the first range query after change */
+	mutable TArray<TPair<FPsDataIndexKey, UPsData*>> Ordered;
+
+	/** Ordered doesn't match Keys */
+	mutable bool bOrderedDirty;
+
+	/** Sort Ordered if it's dirty */
+	void UpdateOrdered() const;
+};
+
+/***********************************
+ * FPsDataCollectionIndex
+ ***********************************/
+
+/** Indexes of all DMETA(Index) properties for elements of one collection */
+struct PSDATAPLUGIN_API FPsDataCollectionIndex
+{
+public:
+	FPsDataCollectionIndex(UPsData* InOwner, const TSharedPtr<const FDataField>& InCollectionField);
+
+	/** Add element added to collection */
+	void Add(UPsData* Data);
+
+	/** Remove element removed from collection */
+	void Remove(UPsData* Data);
+
+	/** Update index after property change of element */
+	void Update(UPsData* Data, const TSharedPtr<const FDataField>& Field);
+
+	/** Get index by property hash, nullptr if property is not indexed */
+	const FPsDataFieldIndex* GetFieldIndex(int32 FieldHash);
+
+private:
+	UPsData* Owner;
+	TSharedPtr<const FDataField> CollectionField;
+	TArray<FPsDataFieldIndex> FieldIndices;
+
+	/** Index isn't built yet, it's built on first query and maintained incrementally after that */
+	bool bDirty;
+
+	void Rebuild();
+};
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Collection/PsDataCollectionIndex.h"
+#include "Collection/PsDataQuery.h"
 #include "PsData.h"
 #include "PsDataCore.h"
 #include "PsDataEvent.h"
@@ -48,7 +50,7 @@ public:
 
 	FPsDataBaseMapProxy(UPsData* InInstance, int32 Hash)
 		: Instance(InInstance)
-		, Property(GetProperty(InInstance, FDataReflection::GetFieldByHash(InInstance->GetClass(), Hash)))
+		, Property(GetProperty(InInstance, FDataReflection::GetFieldByHash(InInstance, Hash)))
 	{
 		check(IsValid());
 	}
@@ -107,25 +109,22 @@ public:
 		typename = typename TEnableIf<!bOtherConst>::Type>
 	void Add(const FString& Key, typename FDataReflectionTools::TConstRef<T, false>::Type Element)
 	{
-		auto NewMap = Property->Get();
-		NewMap.Add(Key, Element);
-		Property->Set(NewMap, Instance.Get());
+		Property->AddElement(Key, Element, Instance.Get());
 	}
 
+	/** Add or replace elements with single change event */
 	template <bool bOtherConst = bConst,
 		typename = typename TEnableIf<!bOtherConst>::Type>
-	bool Remove(const FString& Key)
+	void Append(const TMap<FString, T>& Elements)
 	{
-		auto& Map = Property->Get();
-		if (Map.Find(Key))
-		{
-			auto NewMap = Map;
-			NewMap.Remove(Key);
-			Property->Set(NewMap, Instance.Get());
-			return true;
-		}
+		Property->AppendElements(Elements, Instance.Get());
+	}
 
-		return false;
+	template <bool bOtherConst = bConst,
+		typename = typename TEnableIf<!bOtherConst>::Type>
+	bool Remove(const FString& Key)
+	{
+		return Property->RemoveElement(Key, Instance.Get());
 	}
 
 	template <bool bOtherConst = bConst,
@@ -144,7 +143,7 @@ public:
 
 	typename FDataReflectionTools::TConstValue<TMap<FString, T>, bConst>::Type Get() const
 	{
-		auto& Map = Property->Get();
+		auto& Map = Property->GetSorted();
 		typename FDataReflectionTools::TConstValue<TMap<FString, T>, bConst>::Type Result;
 		Result.Reserve(Map.Num());
 		for (auto& Pair : Map)
@@ -156,7 +155,7 @@ public:
 
 	TArray<FString> GetKeys() const
 	{
-		auto& Map = Property->Get();
+		auto& Map = Property->GetSorted();
 		TArray<FString> Result;
 		Result.Reserve(Map.Num());
 		for (auto& Pair : Map)
@@ -168,7 +167,7 @@ public:
 
 	typename FDataReflectionTools::TConstValue<TArray<T>, bConst>::Type GetValues() const
 	{
-		auto& Map = Property->Get();
+		auto& Map = Property->GetSorted();
 		typename FDataReflectionTools::TConstValue<TArray<T>, bConst>::Type Result;
 		Result.Reserve(Map.Num());
 		for (auto& Pair : Map)
@@ -193,6 +192,35 @@ public:
 		return Property->Get().FindChecked(Key);
 	}
 
+	template <typename V>
+	TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> FindByIndex(int32 FieldHash, const V& Value) const
+	{
+		TArray<UPsData*> Result;
+		if (const FPsDataFieldIndex* Index = FDataReflectionTools::FPsDataFriend::GetCollectionIndex(Instance.Get(), Property->GetField()).GetFieldIndex(FieldHash))
+		{
+			Index->Find(FPsDataIndexKey(Value), Result);
+		}
+		return CastIndexed(Result);
+	}
+
+	template <typename V>
+	TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> FindRangeByIndex(int32 FieldHash, const V& Min, const V& Max) const
+	{
+		TArray<UPsData*> Result;
+		if (const FPsDataFieldIndex* Index = FDataReflectionTools::FPsDataFriend::GetCollectionIndex(Instance.Get(), Property->GetField()).GetFieldIndex(FieldHash))
+		{
+			Index->FindRange(FPsDataIndexKey(Min), FPsDataIndexKey(Max), Result);
+		}
+		return CastIndexed(Result);
+	}
+
+	TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> Query(const FPsDataQuery& Query) const
+	{
+		TArray<T> Values;
+		Property->Get().GenerateValueArray(Values);
+		return CastIndexed(Query.Execute(Values));
+	}
+
 	int32 Num() const
 	{
 		return Property->Get().Num();
@@ -203,24 +231,24 @@ public:
 		return Num() == 0;
 	}
 
-	FPsDataBind Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const
+	FPsDataBind Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate, int32 Priority = 0) const
 	{
-		return Instance->BindInternal(Type, Delegate, Property->GetField());
+		return Instance->BindInternal(FName(*Type), Delegate, Property->GetField(), Priority);
 	}
 
-	FPsDataBind Bind(const FString& Type, const FPsDataDelegate& Delegate) const
+	FPsDataBind Bind(const FString& Type, const FPsDataDelegate& Delegate, int32 Priority = 0) const
 	{
-		return Instance->BindInternal(Type, Delegate, Property->GetField());
+		return Instance->BindInternal(FName(*Type), Delegate, Property->GetField(), Priority);
 	}
 
 	void Unbind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const
 	{
-		Instance->UnbindInternal(Type, Delegate, Property->GetField());
+		Instance->UnbindInternal(FName(*Type, FNAME_Find), Delegate, Property->GetField());
 	}
 
 	void Unbind(const FString& Type, const FPsDataDelegate& Delegate) const
 	{
-		Instance->UnbindInternal(Type, Delegate, Property->GetField());
+		Instance->UnbindInternal(FName(*Type, FNAME_Find), Delegate, Property->GetField());
 	}
 
 	typename FDataReflectionTools::TConstRef<T, bConst>::Type operator[](const FString& Key) const
@@ -228,6 +256,18 @@ public:
 		return Property->Get().FindChecked(Key);
 	}
 
+private:
+	static TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> CastIndexed(const TArray<UPsData*>& Data)
+	{
+		TArray<typename FDataReflectionTools::TConstValue<T, bConst>::Type> Result;
+		Result.Reserve(Data.Num());
+		for (UPsData* Element : Data)
+		{
+			Result.Add(static_cast<typename FDataReflectionTools::TConstValue<T, bConst>::Type>(Element));
+		}
+		return Result;
+	}
+
 	/***********************************
      * TProxyIterator
      ***********************************/
@@ -257,7 +297,7 @@ public:
 			: Proxy(InProxy)
 			, Index(0)
 		{
-			auto& Map = Proxy.Property->Get();
+			auto& Map = Proxy.Property->GetSorted();
 			if (bEnd)
 			{
 				Index = Map.Num();
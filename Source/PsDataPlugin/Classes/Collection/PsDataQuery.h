@@ -0,0 +1,134 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "Collection/PsDataCollectionIndex.h"
+#include "PsDataCore.h"
+#include "PsDataField.h"
+
+#include "CoreMinimal.h"
+
+#include "PsDataQuery.generated.h"
+
+class UPsData;
+
+UENUM(BlueprintType)
+enum class EPsDataQueryOperator : uint8
+{
+	Equal,
+	NotEqual,
+	Less,
+	LessOrEqual,
+	Greater,
+	GreaterOrEqual,
+};
+
+/***********************************
+ * FPsDataQuery
+ ***********************************/
+
+/**
+ * Query over data collection elements: where, order by, limit and projection.
+ * Properties are resolved once when the query is built.
+ */
+struct PSDATAPLUGIN_API FPsDataQuery
+{
+public:
+	FPsDataQuery();
+	FPsDataQuery(UClass* InClass);
+
+	/** Element class */
+	UClass* GetClass() const;
+
+	/** All properties were resolved */
+	bool IsValid() const;
+
+	/** Keep elements with property value matching operator */
+	FPsDataQuery& Where(const FString& FieldName, EPsDataQueryOperator Operator, const FPsDataIndexKey& Value);
+
+	/** Sort elements by property value, first call is primary order */
+	FPsDataQuery& OrderBy(const FString& FieldName, bool bDescending = false);
+
+	/** Keep first elements */
+	FPsDataQuery& Limit(int32 Count);
+
+	/** Property for projection */
+	FPsDataQuery& Select(const FString& FieldName);
+
+	/** Execute query */
+	template <typename T>
+	TArray<UPsData*> Execute(const TArray<T*>& Elements) const
+	{
+		static_assert(TIsDerivedFrom<typename TRemoveConst<T>::Type, UPsData>::IsDerived, "Query elements must be UPsData");
+
+		TArray<int32> Indices;
+		Evaluate(reinterpret_cast<UPsData* const*>(Elements.GetData()), Elements.Num(), Indices);
+
+		TArray<UPsData*> Result;
+		Result.Reserve(Indices.Num());
+		for (const int32 Index : Indices)
+		{
+			Result.Add(const_cast<UPsData*>(static_cast<const UPsData*>(Elements[Index])));
+		}
+		return Result;
+	}
+
+	/** Values of Select property for data */
+	template <typename V>
+	TArray<V> Project(const TArray<UPsData*>& Data) const
+	{
+		TArray<V> Result;
+		if (!Projection.IsValid())
+		{
+			UE_LOG(LogData, Error, TEXT("Query projection is not selected"));
+			return Result;
+		}
+
+		Result.Reserve(Data.Num());
+		for (UPsData* Element : Data)
+		{
+			V* ValuePtr = nullptr;
+			if (FDataReflectionTools::GetByField(Element, Projection, ValuePtr))
+			{
+				Result.Add(*ValuePtr);
+			}
+		}
+		return Result;
+	}
+
+	/** Values of Select property for data as keys */
+	TArray<FPsDataIndexKey> Project(const TArray<UPsData*>& Data) const;
+
+private:
+	struct FCondition
+	{
+		TSharedPtr<const FDataField> Field;
+		FPsDataIndexKey::FReader Reader;
+		EPsDataQueryOperator Operator;
+		FPsDataIndexKey Value;
+	};
+
+	struct FOrder
+	{
+		TSharedPtr<const FDataField> Field;
+		FPsDataIndexKey::FReader Reader;
+		bool bDescending;
+	};
+
+	UClass* Class;
+	TArray<FCondition> Conditions;
+	TArray<FOrder> Orders;
+	TSharedPtr<const FDataField> Projection;
+	FPsDataIndexKey::FReader ProjectionReader;
+	int32 LimitCount;
+	bool bValid;
+
+	/** Resolve property of element class */
+	const TSharedPtr<const FDataField>& FindField(const FString& FieldName, FPsDataIndexKey::FReader& OutReader);
+
+	/** Indices of result elements */
+	void Evaluate(UPsData* const* Elements, int32 Num, TArray<int32>& OutIndices) const;
+
+	/** Element passes all conditions */
+	bool Test(UPsData* Element) const;
+};
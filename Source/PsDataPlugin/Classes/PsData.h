@@ -19,6 +19,9 @@ DECLARE_DELEGATE_OneParam(FPsDataDelegate, UPsDataEvent*);
 
 class UPsData;
 class UPsDataRoot;
+struct FDataClassLayout;
+struct FPsDataCollectionIndex;
+struct FPsDataMemoryUsage;
 
 class PSDATAPLUGIN_API FDataDelegates
 {
@@ -44,6 +47,19 @@ struct PSDATAPLUGIN_API FAbstractDataProperty
 	virtual void Reset(UPsData* Instance) = 0;
 	virtual void Allocate(UPsData* Instance){};
 	virtual TSharedPtr<const FDataField> GetField() const = 0;
+
+	/** Capture current value, returned function restores it */
+	virtual TFunction<void(UPsData*)> Snapshot() { return nullptr; }
+
+	/** Heap memory used by container value */
+	virtual SIZE_T GetAllocatedSize() const { return 0; }
+
+	/** Revision of data map, incremented by owner on change, links resolved through the map are cached by it */
+	virtual uint32 GetRevision() const { return 0; }
+	virtual void IncrementRevision() {}
+
+	/** Copy value of same property of other instance without events, data values are cloned */
+	virtual void CopyFrom(UPsData* Instance, const FAbstractDataProperty* Source) = 0;
 };
 
 /***********************************
@@ -58,10 +74,71 @@ struct PSDATAPLUGIN_API FPsDataFriend
 	static void AddChild(UPsData* Parent, UPsData* Data);
 	static void RemoveChild(UPsData* Parent, UPsData* Data);
 	static void Changed(UPsData* Data, const TSharedPtr<const FDataField>& Field);
+	static void ChangedElement(UPsData* Data, const TSharedPtr<const FDataField>& Field, FName Type, int32 Index);
+
+	/** Called by property before its value is modified */
+	static void Changing(UPsData* Data, FAbstractDataProperty* Property);
+
+	/** Broadcast field event and schedule Changed event, Bubbled filters parents reached by coalesced events */
+	static void BroadcastChanged(UPsData* Data, const TSharedPtr<const FDataField>& Field, TSet<TPair<const UPsData*, const FDataField*>>* Bubbled = nullptr);
+
+	/** Broadcast pooled event and return it to pool */
+	static void Broadcast(UPsData* Data, UPsDataEvent* Event);
+
+	/** Broadcast event to listeners now, called by FPsDataEventQueue */
+	static void DispatchEvent(const UPsData* Data, UPsDataEvent* Event);
+
+	/** Broadcast array element event */
+	static void BroadcastElement(UPsData* Data, const TSharedPtr<const FDataField>& Field, FName Type, int32 Index);
+
+	/** Broadcast deferred Changed event, called by FPsDataChangeDispatcher */
+	static void DispatchChanged(UPsData* Data);
+	static void ResetChanged(UPsData* Data);
+
+	/** Number of delegate wrappers alive for event type in all data */
+	static void AddListener(FName Type);
+	static void RemoveListener(FName Type);
+	static bool HasListeners(FName Type);
+
+	/** Copy of data tree made property by property without events, cached hash is copied */
+	static UPsData* Clone(const UPsData* Source, UObject* Outer);
+
+	/** Attach/detach child of data being cloned without events */
+	static void AttachClone(UPsData* Parent, UPsData* Data, const FString& Name, const FString& CollectionName);
+	static void DetachClone(UPsData* Parent, UPsData* Data);
+
+	/** Add memory used by data to usage */
+	static void CountMemory(const UPsData* Data, FPsDataMemoryUsage& Usage);
+
+	/** Drop hash of data and parents, stops at data already in Dropped */
+	static void DropHash(UPsData* Data, TSet<UPsData*>& Dropped);
 	static void InitProperties(UPsData* Data);
 	static TArray<FAbstractDataProperty*>& GetProperties(UPsData* Data);
+	static const TSet<UPsData*>& GetChildren(const UPsData* Data);
 	static void Serialize(const UPsData* Data, FPsDataSerializer* Serializer);
 	static void Deserialize(UPsData* Data, FPsDataDeserializer* Deserializer);
+	static void PostDeserialize(UPsData* Data);
+	static const FDataClassLayout* GetLayout(const UPsData* Data);
+
+	/** Shared name of array element with index, reference stays valid for program lifetime */
+	static const FString& GetIndexName(int32 Index);
+
+	/** Resolved link targets, nullptr if data, its root or target collection changed since caching or data is detached */
+	static const TArray<UPsData*>* FindLinkCache(const UPsData* Data, int32 LinkHash);
+	static void SetLinkCache(const UPsData* Data, int32 LinkHash, const TArray<UPsData*>& Targets, UPsData* CollectionOwner, const TSharedPtr<const FDataField>& CollectionField);
+
+	/** Index of DMETA(Index) properties for collection elements */
+	static FPsDataCollectionIndex& GetCollectionIndex(UPsData* Data, const TSharedPtr<const FDataField>& Field);
+
+private:
+	/** Add/remove child to/from index of its collection */
+	static void IndexChild(UPsData* Parent, UPsData* Data, bool bAdd);
+
+	/** Resolve collection field after parent or collection name change */
+	static void UpdateCollectionField(UPsData* Data);
+
+	/** Number of delegate wrappers by event type */
+	static TMap<FName, int32> NumTypeListeners;
 };
 } // namespace FDataReflectionTools
 
@@ -74,19 +151,35 @@ struct FDelegateWrapper
 	FPsDataDynamicDelegate DynamicDelegate;
 	FPsDataDelegate Delegate;
 	TSharedPtr<const FDataField> Field;
+	FName Type;
+	int32 Priority;
 
-	FDelegateWrapper(const FPsDataDynamicDelegate& InDynamicDelegate, TSharedPtr<const FDataField> InField = nullptr)
+	FDelegateWrapper(FName InType, const FPsDataDynamicDelegate& InDynamicDelegate, TSharedPtr<const FDataField> InField = nullptr, int32 InPriority = 0)
 		: DynamicDelegate(InDynamicDelegate)
 		, Field(InField)
+		, Type(InType)
+		, Priority(InPriority)
 	{
+		FDataReflectionTools::FPsDataFriend::AddListener(Type);
 	}
 
-	FDelegateWrapper(const FPsDataDelegate& InDelegate, TSharedPtr<const FDataField> InField = nullptr)
+	FDelegateWrapper(FName InType, const FPsDataDelegate& InDelegate, TSharedPtr<const FDataField> InField = nullptr, int32 InPriority = 0)
 		: Delegate(InDelegate)
 		, Field(InField)
+		, Type(InType)
+		, Priority(InPriority)
+	{
+		FDataReflectionTools::FPsDataFriend::AddListener(Type);
+	}
+
+	~FDelegateWrapper()
 	{
+		FDataReflectionTools::FPsDataFriend::RemoveListener(Type);
 	}
 
+	FDelegateWrapper(const FDelegateWrapper&) = delete;
+	FDelegateWrapper& operator=(const FDelegateWrapper&) = delete;
+
 	bool IsBound() const
 	{
 		return DynamicDelegate.IsBound() || Delegate.IsBound();
@@ -174,12 +267,21 @@ private:
 	/** Properties */
 	TArray<FAbstractDataProperty*> Properties;
 
+	/** Compiled class layout */
+	mutable const FDataClassLayout* Layout;
+
+	/** Incremented by every property change */
+	uint32 Revision;
+
 	/** Data name */
 	FString DataKey;
 
 	/** Data collection name */
 	FString CollectionKey;
 
+	/** Property of parent named by CollectionKey, compared in event path instead of the name */
+	const FDataField* CollectionField;
+
 	/** Parent */
 	UPROPERTY()
 	TWeakObjectPtr<UPsData> Parent;
@@ -188,18 +290,45 @@ private:
 	UPROPERTY()
 	TSet<UPsData*> Children;
 
-	/** Broadcast in progress (necessary for correct iteration by delegates) */
-	mutable int32 BroadcastInProgress;
+	/** Some delegate wrappers are unbound and wait for compaction */
+	mutable bool bDelegatesDirty;
+
+	/** Number of delegate wrappers of data and all its children */
+	mutable int32 NumListeners;
 
 	/** Changed flag */
 	bool bChanged;
 
+	/** Immutable list of delegate wrappers, replaced on bind and compaction */
+	typedef TArray<TSharedRef<FDelegateWrapper>> FDelegateList;
+
 	/** Map of delegat wrappers */
-	mutable TMap<FString, TArray<TSharedRef<FDelegateWrapper>>> Delegates;
+	mutable TMap<FName, TSharedRef<const FDelegateList>> Delegates;
 
 	/** Data hash */
 	mutable TOptional<FPsDataMD5Hash> Hash;
 
+	/** Incremented whenever any data is attached or detached, link caches recheck root only after that */
+	static uint32 AttachGeneration;
+
+	/** Resolved link */
+	struct FLinkCache
+	{
+		uint32 Revision;
+		TWeakObjectPtr<UPsDataRoot> Root;
+		uint32 AttachGeneration;
+		TWeakObjectPtr<UPsData> CollectionOwner;
+		int32 CollectionIndex;
+		uint32 CollectionRevision;
+		TArray<UPsData*> Targets;
+	};
+
+	/** Resolved links by link hash */
+	mutable TMap<int32, FLinkCache> LinkCache;
+
+	/** Indexes of collections by collection name */
+	TMap<FString, TSharedPtr<FPsDataCollectionIndex>> CollectionIndices;
+
 private:
 	/** Post init properties */
 	virtual void PostInitProperties() override;
@@ -224,14 +353,14 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (Category = "PsData|Data"))
 	bool IsBound(const FString& Type, bool bBubbles) const;
 
-	/** Broadcat */
+	/** Broadcat, event is queued if FPsDataEventQueue is not in Immediate mode */
 	void Broadcast(UPsDataEvent* Event) const;
 
-	/** Bind */
-	FPsDataBind Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const;
+	/** Bind, listeners with higher priority are called first */
+	FPsDataBind Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate, int32 Priority = 0) const;
 
-	/** Bind */
-	FPsDataBind Bind(const FString& Type, const FPsDataDelegate& Delegate) const;
+	/** Bind, listeners with higher priority are called first */
+	FPsDataBind Bind(const FString& Type, const FPsDataDelegate& Delegate, int32 Priority = 0) const;
 
 	/** Bind */
 	void Unbind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const;
@@ -241,10 +370,10 @@ public:
 
 protected:
 	/** Bind */
-	FPsDataBind Bind(int32 FieldHash, const FPsDataDynamicDelegate& Delegate) const;
+	FPsDataBind Bind(int32 FieldHash, const FPsDataDynamicDelegate& Delegate, int32 Priority = 0) const;
 
 	/** Bind */
-	FPsDataBind Bind(int32 FieldHash, const FPsDataDelegate& Delegate) const;
+	FPsDataBind Bind(int32 FieldHash, const FPsDataDelegate& Delegate, int32 Priority = 0) const;
 
 	/** Bind */
 	void Unbind(int32 FieldHash, const FPsDataDynamicDelegate& Delegate) const;
@@ -267,23 +396,35 @@ private:
 	template <typename T, bool bConst>
 	friend struct FPsDataBaseArrayProxy;
 
-	/** Update delegates */
+	/** Remove unbound delegate wrappers if any */
 	void UpdateDelegates() const;
 
+	/** Replace list of delegate wrappers with copy extended by wrapper, list is ordered by priority */
+	void AddDelegate(FName Type, const TSharedRef<FDelegateWrapper>& Wrapper) const;
+
 	/** Broadcast internal */
 	void BroadcastInternal(UPsDataEvent* Event, const UPsData* Previous = nullptr) const;
 
+	/** Is bound on this data or its parents, rejects event types without listeners in O(1), then skips data without listeners except in the child it's reached from */
+	bool IsBoundInternal(FName Type, bool bBubbles) const;
+
+	/** Is bound on this data */
+	bool IsBoundOwn(FName Type) const;
+
+	/** Add to listener count of data and its parents */
+	void AddNumListeners(int32 Delta) const;
+
 	/** Bind internal */
-	FPsDataBind BindInternal(const FString& Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr) const;
+	FPsDataBind BindInternal(FName Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr, int32 Priority = 0) const;
 
 	/** Bind internal */
-	FPsDataBind BindInternal(const FString& Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr) const;
+	FPsDataBind BindInternal(FName Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr, int32 Priority = 0) const;
 
 	/** Unbind internal */
-	void UnbindInternal(const FString& Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr) const;
+	void UnbindInternal(FName Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr) const;
 
 	/** Unbind internal */
-	void UnbindInternal(const FString& Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr) const;
+	void UnbindInternal(FName Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field = nullptr) const;
 
 public:
 	/***********************************
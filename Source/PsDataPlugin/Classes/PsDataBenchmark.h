@@ -0,0 +1,31 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "PsDataAPI.h"
+
+#include "CoreMinimal.h"
+
+#include "PsDataBenchmark.generated.h"
+
+/** Node of synthetic tree used by PsData.Benchmark console command */
+UCLASS()
+class PSDATAPLUGIN_API UPsDataBenchmarkNode : public UPsData
+{
+	GENERATED_BODY()
+
+	DMETA(Event)
+	DPROP(int32, IntValue);
+
+	DPROP(float, FloatValue);
+
+	DPROP(bool, BoolValue);
+
+	DPROP(FString, StringValue);
+
+	DARRAY(int32, Numbers);
+
+	DARRAY(UPsDataBenchmarkNode*, Array);
+
+	DMAP(UPsDataBenchmarkNode*, Map);
+};
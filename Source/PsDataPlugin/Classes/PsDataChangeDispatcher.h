@@ -0,0 +1,70 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "PsDataDeferredQueue.h"
+
+#include "CoreMinimal.h"
+
+class UPsData;
+
+/***********************************
+ * EPsDataChangeFlush
+ ***********************************/
+
+enum class EPsDataChangeFlush : uint8
+{
+	/** Flush from core ticker once per frame */
+	EndOfFrame,
+
+	/** Flush only by explicit Flush call */
+	Manual,
+};
+
+/***********************************
+ * FPsDataChangeDispatcher
+ ***********************************/
+
+/** Collects changed data and broadcasts deferred Changed event for each of them in one batch */
+class PSDATAPLUGIN_API FPsDataChangeDispatcher
+{
+public:
+	FPsDataChangeDispatcher();
+
+	/** Dispatcher instance */
+	static FPsDataChangeDispatcher& Get();
+
+	/** Add changed data, data is added once until flushed. Game thread only */
+	void Add(UPsData* Data);
+
+	/** Broadcast Changed event for all pending data */
+	void Flush();
+
+	/** Drop pending data and stop ticking */
+	void Reset();
+
+	/** Number of pending data */
+	int32 Num() const;
+
+	/** Set flush point */
+	void SetFlushMode(EPsDataChangeFlush Mode);
+
+	/** Get flush point */
+	EPsDataChangeFlush GetFlushMode() const;
+
+	/** Set max number of data flushed per frame, the rest is flushed in next frames. Zero is unlimited */
+	void SetFrameBudget(int32 Budget);
+
+	/** Get max number of data flushed per frame */
+	int32 GetFrameBudget() const;
+
+private:
+	/** Pending data */
+	TPsDataDeferredQueue<TWeakObjectPtr<UPsData>> Queue;
+
+	/** Flush point */
+	EPsDataChangeFlush FlushMode;
+
+	/** Max number of data flushed per frame */
+	int32 FrameBudget;
+};
@@ -7,6 +7,7 @@
 #include "PsDataField.h"
 #include "PsDataFunctionLibrary.h"
 #include "PsDataProperty.h"
+#include "PsDataStats.h"
 #include "PsDataTraits.h"
 #include "PsDataUtils.h"
 
@@ -24,6 +25,8 @@ template <typename Type, class ReturnType, int32 Hash>
 struct FDLinkBase;
 } // namespace FDataReflectionTools
 
+struct FPsDataPath;
+
 struct PSDATAPLUGIN_API FDataClassFields
 {
 	TMap<FString, const TSharedPtr<const FDataField>> FieldsByName;
@@ -32,13 +35,44 @@ struct PSDATAPLUGIN_API FDataClassFields
 
 	TMap<FString, const TSharedPtr<const FDataLink>> LinksByName;
 	TMap<int32, const TSharedPtr<const FDataLink>> LinksByHash;
+
+	FPsDataClassPlan Plan;
+
+	/** Link paths of root class compiled with reflection, read-only after compile */
+	TMap<FString, TSharedPtr<const FPsDataPath>> Paths;
+};
+
+/** Flat field tables of compiled class */
+struct PSDATAPLUGIN_API FDataClassLayout
+{
+	/** Dense class index */
+	int32 ClassIndex;
+
+	/** Fields ordered by index */
+	TArray<TSharedPtr<const FDataField>> Fields;
+
+	/** Sorted field hashes */
+	TArray<int32> Hashes;
+
+	/** Field index for every sorted hash */
+	TArray<int32> HashIndices;
+
+	FDataClassLayout();
+
+	const TSharedPtr<const FDataField>& FindByIndex(int32 Index) const;
+	const TSharedPtr<const FDataField>& FindByHash(int32 Hash) const;
+	const TSharedPtr<const FDataField>& FindByName(const FString& Name) const;
+
+	/** Hash of field name, same as property hash */
+	static int32 NameHash(const FString& Name);
 };
 
 struct PSDATAPLUGIN_API FDataReflection
 {
 private:
 	static TMap<UClass*, FDataClassFields> FieldsByClass;
-	static TMap<FString, const TArray<FString>> SplittedPath;
+	static TMap<const UClass*, int32> LayoutIndices;
+	static TArray<FDataClassLayout> Layouts;
 	static TArray<const char*> MetaCollection;
 
 	static bool bCompiled;
@@ -58,19 +92,31 @@ public:
 	static const TSharedPtr<const FDataField>& GetFieldByAlias(UClass* OwnerClass, const FString& Alias);
 	static const TSharedPtr<const FDataField>& GetFieldByHash(UClass* OwnerClass, int32 Hash);
 
+	/** Field lookup through the layout cached by instance */
+	static const TSharedPtr<const FDataField>& GetFieldByName(const UPsData* Instance, const FString& Name);
+	static const TSharedPtr<const FDataField>& GetFieldByHash(const UPsData* Instance, int32 Hash);
+	static const TSharedPtr<const FDataField>& GetFieldByIndex(const UPsData* Instance, int32 Index);
+
 	static const TMap<FString, const TSharedPtr<const FDataField>>& GetFields(const UClass* OwnerClass);
 	static const TMap<FString, const TSharedPtr<const FDataField>>& GetAliasFields(const UClass* OwnerClass);
 
+	/** Serialization plan, available after compile */
+	static const FPsDataClassPlan* GetClassPlan(const UClass* OwnerClass);
+
+	/** Flat field tables, available after compile */
+	static const FDataClassLayout* GetClassLayout(const UClass* OwnerClass);
+
 	static const TSharedPtr<const FDataLink>& GetLinkByName(UClass* OwnerClass, const FString& Name);
 	static const TSharedPtr<const FDataLink>& GetLinkByHash(UClass* OwnerClass, int32 Hash);
 
 	static const TMap<FString, const TSharedPtr<const FDataLink>>& GetLinks(UClass* OwnerClass);
 
+	/** Link path precompiled against root class, nullptr for other paths which should be parsed in place */
+	static const FPsDataPath* FindPath(const UClass* OwnerClass, const FString& Path);
+
 	static bool HasClass(const UClass* OwnerClass);
 
 	static void Compile();
-
-	static const TArray<FString>& SplitPath(const FString& Path);
 };
 
 /***********************************
@@ -219,7 +265,7 @@ bool GetByField(UPsData* Instance, const TSharedPtr<const FDataField>& Field, TM
 template <typename T>
 bool GetByHash(UPsData* Instance, int32 Hash, T*& OutValue)
 {
-	auto& Field = FDataReflection::GetFieldByHash(Instance->GetClass(), Hash);
+	auto& Field = FDataReflection::GetFieldByHash(Instance, Hash);
 	if (Field.IsValid())
 	{
 		return GetByField(Instance, Field, OutValue);
@@ -242,7 +288,7 @@ bool GetByPath(UPsData* Instance, const TArray<FString>& Path, int32 PathOffset,
 	check(PathLength <= Path.Num());
 	check(Delta > 0);
 
-	auto& Field = FDataReflection::GetFieldByName(Instance->GetClass(), Path[PathOffset]);
+	auto& Field = FDataReflection::GetFieldByName(Instance, Path[PathOffset]);
 	if (Field.IsValid())
 	{
 		if (Delta == 1)
@@ -418,31 +464,171 @@ bool GetByPath(UPsData* Instance, const TArray<FString>& Path, int32 PathOffset,
 
 	return false;
 }
+} // namespace FDataReflectionTools
 
+/***********************************
+ * FPsDataPath
+ ***********************************/
+
+enum class EPsDataPathElement : uint8
+{
+	None,
+	ArrayIndex,
+	MapKey,
+};
+
+struct PSDATAPLUGIN_API FPsDataPathStep
+{
+	/** Property */
+	TSharedPtr<const FDataField> Field;
+
+	/** Element access after property */
+	EPsDataPathElement Element;
+
+	/** Array index for EPsDataPathElement::ArrayIndex */
+	int32 ArrayIndex;
+
+	/** Map key for EPsDataPathElement::MapKey */
+	FString Key;
+
+	FPsDataPathStep();
+};
+
+/** Path compiled against class, evaluated without string parsing */
+struct PSDATAPLUGIN_API FPsDataPath
+{
+public:
+	FPsDataPath();
+	FPsDataPath(const UClass* InClass, const FString& InPath);
+
+	/** Path was compiled successfully */
+	bool IsValid() const;
+
+	/** Class the path was compiled against */
+	const UClass* GetClass() const;
+
+	/** Source path */
+	const FString& GetPath() const;
+
+	/** Data owning property of the last step and the property, nullptr if path can't be resolved */
+	UPsData* GetPropertyOwner(UPsData* Instance, TSharedPtr<const FDataField>& OutField) const;
+
+	/** Get value by path */
+	template <typename T>
+	bool Get(UPsData* Instance, T*& OutValue) const
+	{
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataGetByPath);
+
+		OutValue = nullptr;
+
+		UPsData* Owner = GetOwner(Instance);
+		if (Owner == nullptr)
+		{
+			return false;
+		}
+
+		if (!Tail.IsEmpty())
+		{
+			const TSharedPtr<const FPsDataPath> TailPath = GetTailPath(Owner);
+			return TailPath.IsValid() && TailPath->Get(Owner, OutValue);
+		}
+
+		const FPsDataPathStep& Step = Steps.Last();
+		if (Step.Element == EPsDataPathElement::None)
+		{
+			return FDataReflectionTools::GetByField(Owner, Step.Field, OutValue);
+		}
+		else if (Step.Element == EPsDataPathElement::ArrayIndex)
+		{
+			TArray<T>* ArrayPtr = nullptr;
+			if (FDataReflectionTools::GetByField(Owner, Step.Field, ArrayPtr))
+			{
+				if (ArrayPtr->IsValidIndex(Step.ArrayIndex))
+				{
+					OutValue = &(*ArrayPtr)[Step.ArrayIndex];
+					return true;
+				}
+
+				check(false && "Can't find property by index");
+			}
+		}
+		else
+		{
+			TMap<FString, T>* MapPtr = nullptr;
+			if (FDataReflectionTools::GetByField(Owner, Step.Field, MapPtr))
+			{
+				OutValue = MapPtr->Find(Step.Key);
+				if (OutValue)
+				{
+					return true;
+				}
+
+				check(false && "Can't find property by name");
+			}
+		}
+
+		return false;
+	}
+
+private:
+	friend struct FDataReflection;
+
+	const UClass* Class;
+	FString Path;
+	TArray<FPsDataPathStep> Steps;
+
+	/** Rest of path with property missing in declared class, compiled against runtime class of owner */
+	FString Tail;
+	const UClass* TailClass;
+
+	/** Tail compiled against child classes of TailClass having its property, filled on reflection compile */
+	TMap<const UClass*, TSharedPtr<const FPsDataPath>> TailPaths;
+
+	/** Owner of last step, or owner of tail */
+	UPsData* GetOwner(UPsData* Instance) const;
+
+	/** Tail compiled against class of owner, parsed in place if it wasn't precompiled, nullptr if tail is invalid for the class */
+	TSharedPtr<const FPsDataPath> GetTailPath(UPsData* Owner) const;
+
+	/** Precompile tail against classes */
+	void CompileTails(const TArray<const UClass*>& Classes);
+};
+
+namespace FDataReflectionTools
+{
 /***********************************
  * GET PROPERTY VALUE BY PATH
  ***********************************/
 
+template <typename T>
+bool GetByPath(UPsData* Instance, const FPsDataPath& Path, T*& OutValue)
+{
+	if (Path.IsValid())
+	{
+		return Path.Get(Instance, OutValue);
+	}
+
+	check(false && "Can't use invalid path");
+	OutValue = nullptr;
+	return false;
+}
+
 template <typename T>
 bool GetByPath(UPsData* Instance, const FString& Path, T*& OutValue)
 {
-	auto& Field = FDataReflection::GetFieldByName(Instance->GetClass(), Path);
+	auto& Field = FDataReflection::GetFieldByName(Instance, Path);
 	if (Field.IsValid())
 	{
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataGetByPath);
 		return GetByField(Instance, Field, OutValue);
 	}
-	else
+
+	if (const FPsDataPath* CompiledPath = FDataReflection::FindPath(Instance->GetClass(), Path))
 	{
-		const auto& PathArray = FDataReflection::SplitPath(Path);
-		if (PathArray.Num() > 1)
-		{
-			return GetByPath<T>(Instance, PathArray, 0, PathArray.Num(), OutValue);
-		}
+		return GetByPath(Instance, *CompiledPath, OutValue);
 	}
 
-	check(false && "Can't find property by name");
-	OutValue = nullptr;
-	return false;
+	return GetByPath(Instance, FPsDataPath(Instance->GetClass(), Path), OutValue);
 }
 
 /***********************************
@@ -452,7 +638,7 @@ bool GetByPath(UPsData* Instance, const FString& Path, T*& OutValue)
 template <typename T>
 bool GetByName(UPsData* Instance, const FString& Name, T*& OutValue)
 {
-	auto& Field = FDataReflection::GetFieldByName(Instance->GetClass(), Name);
+	auto& Field = FDataReflection::GetFieldByName(Instance, Name);
 	if (Field.IsValid())
 	{
 		return GetByField(Instance, Field, OutValue);
@@ -496,7 +682,7 @@ void SetByField(UPsData* Instance, const TSharedPtr<const FDataField>& Field, ty
 template <typename T>
 void SetByHash(UPsData* Instance, int32 Hash, typename FDataReflectionTools::TConstRef<T>::Type NewValue)
 {
-	auto& Field = FDataReflection::GetFieldByHash(Instance->GetClass(), Hash);
+	auto& Field = FDataReflection::GetFieldByHash(Instance, Hash);
 	if (Field.IsValid())
 	{
 		SetByField<T>(Instance, Field, NewValue);
@@ -513,7 +699,7 @@ void SetByHash(UPsData* Instance, int32 Hash, typename FDataReflectionTools::TCo
 template <typename T>
 void SetByName(UPsData* Instance, const FString& Name, typename FDataReflectionTools::TConstRef<T>::Type NewValue)
 {
-	auto& Field = FDataReflection::GetFieldByName(Instance->GetClass(), Name);
+	auto& Field = FDataReflection::GetFieldByName(Instance, Name);
 	if (Field.IsValid())
 	{
 		SetByField<T>(Instance, Field, NewValue);
@@ -0,0 +1,179 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/Ticker.h"
+
+/***********************************
+ * TPsDataDeferredQueue
+ ***********************************/
+
+/**
+ * Game thread queue dispatched in order from core ticker or by Flush.
+ * Entries added by callbacks are dispatched by the next call. Flush and Reset called by callbacks
+ * during dispatch are deferred until the current entry is dispatched.
+ */
+template <typename T>
+class TPsDataDeferredQueue
+{
+public:
+	/** Dispatch entry */
+	TFunction<void(T& Entry)> OnDispatch;
+
+	/** Release entry dropped by reset */
+	TFunction<void(T& Entry)> OnDrop;
+
+	/** Number of entries dispatched by next tick, zero stops ticking */
+	TFunction<int32()> GetTickCount;
+
+	TPsDataDeferredQueue()
+		: Head(0)
+		, bDispatching(false)
+		, bFlushRequested(false)
+		, bResetRequested(false)
+	{
+	}
+
+	/** Add entry and start ticker if needed */
+	void Add(const T& Entry)
+	{
+		check(IsInGameThread());
+
+		Pending.Add(Entry);
+		UpdateTicker();
+	}
+
+	/** Dispatch all entries */
+	void Flush()
+	{
+		if (bDispatching)
+		{
+			bFlushRequested = true;
+			return;
+		}
+
+		Dispatch(Num());
+	}
+
+	/** Drop entries and stop ticking */
+	void Reset()
+	{
+		if (bDispatching)
+		{
+			bResetRequested = true;
+			return;
+		}
+
+		if (OnDrop)
+		{
+			for (int32 i = Head; i < Pending.Num(); ++i)
+			{
+				OnDrop(Pending[i]);
+			}
+		}
+
+		Pending.Empty();
+		Head = 0;
+
+		if (TickerHandle.IsValid())
+		{
+			FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			TickerHandle.Reset();
+		}
+	}
+
+	/** Number of entries waiting for dispatch */
+	int32 Num() const
+	{
+		return Pending.Num() - Head;
+	}
+
+	/** Start ticker if there are entries and tick count allows it */
+	void UpdateTicker()
+	{
+		if (!TickerHandle.IsValid() && Num() > 0 && GetTickCount() > 0)
+		{
+			TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &TPsDataDeferredQueue::Tick));
+		}
+	}
+
+private:
+	/** Ticker callback */
+	bool Tick(float DeltaTime)
+	{
+		const int32 Count = GetTickCount();
+		if (Count > 0)
+		{
+			Dispatch(Count);
+		}
+
+		if (Count == 0 || Num() == 0)
+		{
+			TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	/** Dispatch first Count entries */
+	void Dispatch(int32 Count)
+	{
+		check(!bDispatching);
+		bDispatching = true;
+
+		int32 End = Head + Count;
+		while (Head < End && Head < Pending.Num() && !bResetRequested)
+		{
+			T Entry = Pending[Head++];
+			OnDispatch(Entry);
+
+			if (bFlushRequested)
+			{
+				bFlushRequested = false;
+				End = Pending.Num();
+			}
+		}
+
+		bDispatching = false;
+
+		if (bResetRequested)
+		{
+			bResetRequested = false;
+			bFlushRequested = false;
+			Reset();
+			return;
+		}
+
+		if (Head == Pending.Num())
+		{
+			Pending.Reset();
+			Head = 0;
+		}
+		else if (Head * 2 >= Pending.Num())
+		{
+			Pending.RemoveAt(0, Head, false);
+			Head = 0;
+		}
+	}
+
+	/** Entries, dispatched ones are before Head */
+	TArray<T> Pending;
+
+	/** Index of first not dispatched entry in Pending */
+	int32 Head;
+
+	/** Dispatch is in progress */
+	bool bDispatching;
+
+	/** Flush was called during dispatch */
+	bool bFlushRequested;
+
+	/** Reset was called during dispatch */
+	bool bResetRequested;
+
+	/** Ticker handle */
+	FDelegateHandle TickerHandle;
+};
@@ -10,6 +10,11 @@
 class UPsData;
 struct FDataField;
 
+namespace FDataReflectionTools
+{
+struct FPsDataFriend;
+} // namespace FDataReflectionTools
+
 UCLASS(BlueprintType, Blueprintable)
 class PSDATAPLUGIN_API UPsDataEvent : public UObject
 {
@@ -28,17 +33,46 @@ public:
 	/** Name Changed */
 	static const FString NameChanged;
 
+	/** Element added to array */
+	static const FString ElementAdded;
+
+	/** Element removed from array */
+	static const FString ElementRemoved;
+
+	/** Element of array replaced */
+	static const FString ElementChanged;
+
+	/** Ids of events above */
+	static const FName AddedId;
+	static const FName RemovingId;
+	static const FName ChangedId;
+	static const FName NameChangedId;
+	static const FName ElementAddedId;
+	static const FName ElementRemovedId;
+	static const FName ElementChangedId;
+
 	UFUNCTION(BlueprintPure, Category = "PsData|Event")
 	static UPsDataEvent* ConstructEvent(FString EventType, bool bEventBubbles);
 
+	/** Get event from pool for native broadcast, event is valid only until Release */
+	static UPsDataEvent* Acquire(FName EventType, bool bEventBubbles);
+
+	/** Return event to pool, event passed to dynamic delegate is left to GC */
+	static void Release(UPsDataEvent* Event);
+
 private:
 	friend class UPsData;
+	friend struct FDataReflectionTools::FPsDataFriend;
 	friend class UPsDataEventFunctionLibrary;
+	friend class FPsDataEventQueue;
 	friend struct FCustomThunkTemplates_PsDataEvent;
 
 protected:
+	/** Type name, filled on first GetType call */
+	mutable FString Type;
+
 	UPROPERTY()
-	FString Type;
+	FName TypeId;
 
 	UPROPERTY()
 	UPsData* Target;
@@ -52,6 +86,21 @@ protected:
 	UPROPERTY()
 	bool bStop;
 
+	UPROPERTY()
+	int32 Index;
+
+	/** Array field of element event */
+	TSharedPtr<const FDataField> Field;
+
+	/** Parents already reached by coalesced event of same type */
+	TSet<TPair<const UPsData*, const FDataField*>>* Bubbled;
+
+	/** Event was passed to dynamic delegate and can't be reused */
+	bool bRetained;
+
+	/** Free events */
+	static TArray<UPsDataEvent*> Pool;
+
 public:
 	/* Const target for c++ */
 	const UPsData* GetTarget() const;
@@ -59,9 +108,19 @@ public:
 	UFUNCTION(BlueprintPure, Category = "PsData|Event")
 	const FString& GetType() const;
 
+	/** Event type id */
+	FName GetTypeId() const;
+
 	UFUNCTION(BlueprintPure, Category = "PsData|Event")
 	bool IsBubbles() const;
 
+	/** Index of element for element events, otherwise INDEX_NONE */
+	UFUNCTION(BlueprintPure, Category = "PsData|Event")
+	int32 GetIndex() const;
+
+	/** Changed field for field and element events, otherwise nullptr */
+	TSharedPtr<const FDataField> GetField() const;
+
 	UFUNCTION(BlueprintCallable, Category = "PsData|Event")
 	void StopImmediatePropagation();
 
@@ -0,0 +1,107 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "PsDataDeferredQueue.h"
+
+#include "CoreMinimal.h"
+
+class UPsData;
+class UPsDataEvent;
+struct FDataField;
+
+/***********************************
+ * EPsDataEventProcessing
+ ***********************************/
+
+enum class EPsDataEventProcessing : uint8
+{
+	/** Broadcast event at once */
+	Immediate,
+
+	/** Broadcast all queued events from core ticker once per frame */
+	EndOfFrame,
+
+	/** Broadcast at most frame budget of queued events per frame, the rest is left for next frames */
+	Budgeted,
+};
+
+/***********************************
+ * FPsDataEventQueue
+ ***********************************/
+
+/**
+ * Global queue of data events. In deferred modes event bubbles through parents data has at the moment
+ * of broadcast, not at the moment of change. Deferred events of a transaction aren't coalesced per parent,
+ * so a parent gets bubbled event once for every changed child instead of once per transaction.
+ */
+class PSDATAPLUGIN_API FPsDataEventQueue
+{
+public:
+	FPsDataEventQueue();
+
+	/** Queue instance */
+	static FPsDataEventQueue& Get();
+
+	/** Broadcast event now or queue it depending on mode. Pooled event is released after broadcast. Game thread only */
+	void Broadcast(const UPsData* Target, UPsDataEvent* Event, bool bPooled);
+
+	/** Broadcast all queued events */
+	void Flush();
+
+	/** Drop queued events and stop ticking */
+	void Reset();
+
+	/** Number of queued events */
+	int32 Num() const;
+
+	/** Set processing mode, switching to Immediate flushes queued events */
+	void SetMode(EPsDataEventProcessing Mode);
+
+	/** Get processing mode */
+	EPsDataEventProcessing GetMode() const;
+
+	/** Set max number of events broadcasted per frame in Budgeted mode */
+	void SetFrameBudget(int32 Budget);
+
+	/** Get max number of events broadcasted per frame in Budgeted mode */
+	int32 GetFrameBudget() const;
+
+	/** Drop event if event of same type, index and field is already queued for same target */
+	void SetMergeDuplicates(bool bMerge);
+
+	/** Is duplicated events dropped */
+	bool IsMergeDuplicates() const;
+
+private:
+	typedef TTuple<const UPsData*, FName, int32, const FDataField*> FEntryKey;
+
+	struct FEntry
+	{
+		TWeakObjectPtr<UPsData> Target;
+		UPsDataEvent* Event;
+		FEntryKey Key;
+		bool bPooled;
+	};
+
+	/** Release or unroot event */
+	static void Free(UPsDataEvent* Event, bool bPooled);
+
+	/** Key for merging */
+	static FEntryKey MakeKey(const UPsData* Target, const UPsDataEvent* Event);
+
+	/** Queued events */
+	TPsDataDeferredQueue<FEntry> Queue;
+
+	/** Keys of queued events for merging */
+	TSet<FEntryKey> PendingKeys;
+
+	/** Processing mode */
+	EPsDataEventProcessing Mode;
+
+	/** Max number of events broadcasted per frame in Budgeted mode */
+	int32 FrameBudget;
+
+	/** Merge duplicated events */
+	bool bMergeDuplicates;
+};
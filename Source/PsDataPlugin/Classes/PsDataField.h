@@ -22,6 +22,7 @@ struct EDataMetaType
 	static const char* ReadOnly;
 	static const char* Deprecated;
 	static const char* Nullable;
+	static const char* Index;
 };
 
 /***********************************
@@ -36,6 +37,7 @@ struct FDataFieldMeta
 	bool bDeprecated;
 	bool bReadOnly;
 	bool bAlias;
+	bool bIndex;
 	FString Alias;
 	FString EventType;
 
@@ -114,6 +116,11 @@ public:
 
 	FDataField(const FString& InName, int32 InIndex, int32 InHash, FAbstractDataTypeContext* InContext, const TArray<const char*>& MetaCollection);
 	const FString& GetChangedEventName() const;
+	FName GetChangedEventId() const;
+
+private:
+	/** Interned event type of GetChangedEventName */
+	FName ChangedEventId;
 };
 
 /***********************************
@@ -10,7 +10,9 @@
 class UPsData;
 class UPsDataBlueprintMapProxy;
 class UPsDataBlueprintArrayProxy;
+struct FDataField;
 struct FDataLink;
+struct FPsDataTransaction;
 
 UCLASS()
 class PSDATAPLUGIN_API UPsDataFunctionLibrary : public UBlueprintFunctionLibrary
@@ -28,6 +30,12 @@ public:
 	/** Get keys by link hash */
 	static void GetLinkKeys(const UPsData* Target, TSharedPtr<const FDataLink> Link, TArray<FString>& OutKeys);
 
+	/** Get linked collection, path of link is compiled once for root class */
+	static TMap<FString, UPsData*>* GetLinkCollection(const UPsData* Target, TSharedPtr<const FDataLink> Link);
+
+	/** Get linked collection with data owning it and its property */
+	static TMap<FString, UPsData*>* GetLinkCollection(const UPsData* Target, TSharedPtr<const FDataLink> Link, UPsData*& OutOwner, TSharedPtr<const FDataField>& OutField);
+
 	/** Get data array property by hash */
 	UFUNCTION(BlueprintPure, Category = "PsData|Data")
 	static TArray<UPsData*> GetDataArrayByLinkHash(const UPsData* Target, int32 Crc32);
@@ -51,4 +59,30 @@ public:
 	/** Get map proxy property */
 	UFUNCTION(BlueprintPure, Category = "PsData|Data")
 	static UPsDataBlueprintArrayProxy* GetArrayProxy(UPsData* Target, int32 Crc32);
+
+	/***********************************
+	 * Transaction
+	 ***********************************/
+
+	/** Begin transaction, field events are delayed until commit. Transaction not finished in frame is committed with warning */
+	UFUNCTION(BlueprintCallable, Category = "PsData|Transaction")
+	static void BeginTransaction();
+
+	/** Commit last transaction started by BeginTransaction */
+	UFUNCTION(BlueprintCallable, Category = "PsData|Transaction")
+	static void CommitTransaction();
+
+	/** Rollback last transaction started by BeginTransaction */
+	UFUNCTION(BlueprintCallable, Category = "PsData|Transaction")
+	static void RollbackTransaction();
+
+private:
+	/** Transactions started by BeginTransaction */
+	static TArray<TUniquePtr<FPsDataTransaction>> Transactions;
+
+	/** Core ticker committing transactions left unfinished by the end of frame */
+	static FDelegateHandle TransactionTickerHandle;
+
+	/** Ticker callback */
+	static bool CommitLeakedTransactions(float DeltaTime);
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPsData;
+
+/***********************************
+ * EPsDataProfilerCounter
+ ***********************************/
+
+enum class EPsDataProfilerCounter : uint8
+{
+	/** Property value changed */
+	Set,
+
+	/** Event broadcasted to data */
+	Broadcast,
+
+	/** Hash calculated */
+	CalculateHash,
+
+	Num,
+};
+
+/***********************************
+ * FPsDataMemoryUsage
+ ***********************************/
+
+/** Bytes used by data */
+struct PSDATAPLUGIN_API FPsDataMemoryUsage
+{
+	/** Object itself with inline property values */
+	SIZE_T Object = 0;
+
+	/** Heap memory of property list and container values */
+	SIZE_T Properties = 0;
+
+	/** Delegate lists and wrappers */
+	SIZE_T Delegates = 0;
+
+	/** Children set */
+	SIZE_T Children = 0;
+
+	/** DataKey and CollectionKey strings */
+	SIZE_T Keys = 0;
+
+	/** Cached hash */
+	SIZE_T Hash = 0;
+
+	SIZE_T GetTotal() const;
+};
+
+/***********************************
+ * FPsDataProfiler
+ ***********************************/
+
+/** Per class churn counters and memory usage, reported by PsData.Stats and PsData.Memory console commands */
+struct PSDATAPLUGIN_API FPsDataProfiler
+{
+	/** Count operation for class of data, does nothing until profiling is started */
+	FORCEINLINE static void Count(const UPsData* Data, EPsDataProfilerCounter Counter)
+	{
+		if (bEnabled)
+		{
+			CountInternal(Data, Counter);
+		}
+	}
+
+	/** Reset counters and start counting */
+	static void Start();
+
+	/** Stop counting, counters are kept for report */
+	static void Stop();
+
+	/** Is counting */
+	static bool IsEnabled();
+
+	/** Log operations per second by class, write CSV if path is not empty */
+	static void ReportStats(const FString& CsvPath);
+
+	/** Log instance count and memory usage by class, write CSV if path is not empty */
+	static void ReportMemory(const FString& CsvPath);
+
+private:
+	struct FClassCounters
+	{
+		uint64 Values[static_cast<int32>(EPsDataProfilerCounter::Num)] = {};
+	};
+
+	static void CountInternal(const UPsData* Data, EPsDataProfilerCounter Counter);
+
+	/** Counting flag */
+	static bool bEnabled;
+
+	/** Counting interval */
+	static double StartTime;
+	static double StopTime;
+
+	/** Counters by class */
+	static TMap<TWeakObjectPtr<UClass>, FClassCounters> Counters;
+};
@@ -5,8 +5,12 @@
 #include "PsData.h"
 #include "PsDataEvent.h"
 #include "PsDataField.h"
+#include "PsDataStats.h"
 #include "PsDataTraits.h"
 #include "PsDataUtils.h"
+#include "Serialize/PsDataBinarySerialization.h"
+#include "Serialize/PsDataFastJsonSerialization.h"
+#include "Serialize/PsDataMsgPackSerialization.h"
 #include "Serialize/PsDataSerialization.h"
 
 #include "CoreMinimal.h"
@@ -73,24 +77,19 @@ struct FTypeComparator<TMap<FString, T>>
 {
 	static bool Compare(const TMap<FString, T>& Value0, const TMap<FString, T>& Value1)
 	{
-		bool bChange = false;
-		if (Value0.Num() == Value1.Num())
+		if (Value0.Num() != Value1.Num())
 		{
-			auto Iterator0 = Value0.CreateConstIterator();
-			auto Iterator1 = Value1.CreateConstIterator();
-			while (Iterator0)
-			{
-				if (!FTypeComparator<FString>::Compare(Iterator0.Key(), Iterator1.Key()) || !FTypeComparator<T>::Compare(Iterator0.Value(), Iterator1.Value()))
-				{
-					return false;
-				}
-				++Iterator0;
-				++Iterator1;
-			}
+			return false;
 		}
-		else
+
+		// Key order is not maintained on insert, so compare by lookup
+		for (const auto& Pair : Value0)
 		{
-			return false;
+			const T* Find = Value1.Find(Pair.Key);
+			if (!Find || !FTypeComparator<T>::Compare(Pair.Value, *Find))
+			{
+				return false;
+			}
 		}
 		return true;
 	}
@@ -138,6 +137,19 @@ struct FTypeSerializerExtended
 	}
 };
 
+/** Serializer for types written with a single WriteValue call, resolved statically for known serializers */
+template <typename T, typename L>
+struct FTypeSerializerDirect : public FTypeSerializerExtended<T, L>
+{
+	using FTypeSerializerExtended<T, L>::Serialize;
+
+	template <typename S>
+	static void Serialize(const UPsData* Instance, const TSharedPtr<const FDataField>& Field, S* Serializer, const T& Value)
+	{
+		Serializer->WriteValue(Value);
+	}
+};
+
 template <typename T, typename L>
 struct FTypeDeserializerExtended
 {
@@ -150,7 +162,8 @@ struct FTypeDeserializerExtended
 template <typename T>
 struct FTypeSerializer<TArray<T>>
 {
-	static void Serialize(const UPsData* Instance, const TSharedPtr<const FDataField>& Field, FPsDataSerializer* Serializer, const TArray<T>& Value)
+	template <typename S>
+	static void Serialize(const UPsData* Instance, const TSharedPtr<const FDataField>& Field, S* Serializer, const TArray<T>& Value)
 	{
 		Serializer->WriteArray();
 		for (const T& Element : Value)
@@ -197,7 +210,8 @@ struct FTypeDeserializer<TArray<T>>
 template <typename T>
 struct FTypeSerializer<TMap<FString, T>>
 {
-	static void Serialize(const UPsData* Instance, const TSharedPtr<const FDataField>& Field, FPsDataSerializer* Serializer, const TMap<FString, T>& Value)
+	template <typename S>
+	static void Serialize(const UPsData* Instance, const TSharedPtr<const FDataField>& Field, S* Serializer, const TMap<FString, T>& Value)
 	{
 		Serializer->WriteObject();
 		for (auto& Pair : Value)
@@ -240,6 +254,31 @@ struct FTypeDeserializer<TMap<FString, T>>
 		return NewValue;
 	}
 };
+
+/***********************************
+ * Static serializer dispatch
+ ***********************************/
+
+/** Resolve serializer type once per property, so nested values are written without virtual calls */
+template <typename T>
+void SerializeStatic(const UPsData* Instance, const TSharedPtr<const FDataField>& Field, FPsDataSerializer* Serializer, const T& Value)
+{
+	switch (Serializer->GetType())
+	{
+	case EPsDataSerializerType::Binary:
+		FTypeSerializer<T>::Serialize(Instance, Field, static_cast<FPsDataBinarySerializer*>(Serializer), Value);
+		break;
+	case EPsDataSerializerType::FastJson:
+		FTypeSerializer<T>::Serialize(Instance, Field, static_cast<FPsDataFastJsonSerializer*>(Serializer), Value);
+		break;
+	case EPsDataSerializerType::MsgPack:
+		FTypeSerializer<T>::Serialize(Instance, Field, static_cast<FPsDataMsgPackSerializer*>(Serializer), Value);
+		break;
+	default:
+		FTypeSerializer<T>::Serialize(Instance, Field, Serializer, Value);
+		break;
+	}
+}
 } // namespace FDataReflectionTools
 
 /***********************************
@@ -259,7 +298,7 @@ struct FDataProperty : public FAbstractDataProperty
 
 	virtual void Serialize(const UPsData* Instance, FPsDataSerializer* Serializer) override
 	{
-		FDataReflectionTools::FTypeSerializer<T>::Serialize(Instance, GetField(), Serializer, Get());
+		FDataReflectionTools::SerializeStatic<T>(Instance, GetField(), Serializer, Get());
 	}
 
 	virtual void Deserialize(UPsData* Instance, FPsDataDeserializer* Deserializer) override
@@ -272,6 +311,19 @@ struct FDataProperty : public FAbstractDataProperty
 		Set(FDataReflectionTools::FTypeDefault<T>::GetDefaultValue(), Instance);
 	}
 
+	virtual TFunction<void(UPsData*)> Snapshot() override
+	{
+		const T OldValue = Value;
+		return [this, OldValue](UPsData* Instance) {
+			Set(OldValue, Instance);
+		};
+	}
+
+	virtual void CopyFrom(UPsData* Instance, const FAbstractDataProperty* Source) override
+	{
+		Value = static_cast<const FDataProperty*>(Source)->Value;
+	}
+
 	const T& Get() const
 	{
 		return Value;
@@ -284,11 +336,14 @@ struct FDataProperty : public FAbstractDataProperty
 
 	void Set(const T& NewValue, UPsData* Instance)
 	{
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataSet);
+
 		if (FDataReflectionTools::FTypeComparator<T>::Compare(Value, NewValue))
 		{
 			return;
 		}
 
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
 		Value = NewValue;
 
 		FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
@@ -313,7 +368,7 @@ struct FDataProperty<TArray<T>> : public FAbstractDataProperty
 
 	virtual void Serialize(const UPsData* Instance, FPsDataSerializer* Serializer) override
 	{
-		FDataReflectionTools::FTypeSerializer<TArray<T>>::Serialize(Instance, GetField(), Serializer, Get());
+		FDataReflectionTools::SerializeStatic<TArray<T>>(Instance, GetField(), Serializer, Get());
 	}
 
 	virtual void Deserialize(UPsData* Instance, FPsDataDeserializer* Deserializer) override
@@ -326,6 +381,24 @@ struct FDataProperty<TArray<T>> : public FAbstractDataProperty
 		Set({}, Instance);
 	}
 
+	virtual TFunction<void(UPsData*)> Snapshot() override
+	{
+		const TArray<T> OldValue = Value;
+		return [this, OldValue](UPsData* Instance) {
+			Set(OldValue, Instance);
+		};
+	}
+
+	virtual void CopyFrom(UPsData* Instance, const FAbstractDataProperty* Source) override
+	{
+		Value = static_cast<const FDataProperty*>(Source)->Value;
+	}
+
+	virtual SIZE_T GetAllocatedSize() const override
+	{
+		return Value.GetAllocatedSize();
+	}
+
 	TArray<T>& Get()
 	{
 		return Value;
@@ -333,15 +406,54 @@ struct FDataProperty<TArray<T>> : public FAbstractDataProperty
 
 	void Set(const TArray<T>& NewValue, UPsData* Instance)
 	{
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataSet);
+
 		if (FDataReflectionTools::FTypeComparator<TArray<T>>::Compare(Value, NewValue))
 		{
 			return;
 		}
 
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
 		Value = NewValue;
 
 		FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
 	}
+
+	int32 AddElement(const T& Element, UPsData* Instance)
+	{
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		const int32 Index = Value.Add(Element);
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, GetField(), UPsDataEvent::ElementAddedId, Index);
+		return Index;
+	}
+
+	void InsertElement(const T& Element, int32 Index, UPsData* Instance)
+	{
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		Value.Insert(Element, Index);
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, GetField(), UPsDataEvent::ElementAddedId, Index);
+	}
+
+	void RemoveElementAt(int32 Index, UPsData* Instance, bool bAllowShrinking = false)
+	{
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		Value.RemoveAt(Index, 1, bAllowShrinking);
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, GetField(), UPsDataEvent::ElementRemovedId, Index);
+	}
+
+	T SetElement(const T& Element, int32 Index, UPsData* Instance)
+	{
+		T OldElement = Value[Index];
+		if (FDataReflectionTools::FTypeComparator<T>::Compare(OldElement, Element))
+		{
+			return OldElement;
+		}
+
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		Value[Index] = Element;
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, GetField(), UPsDataEvent::ElementChangedId, Index);
+		return OldElement;
+	}
 };
 
 /***********************************
@@ -353,7 +465,11 @@ struct FDataProperty<TMap<FString, T>> : public FAbstractDataProperty
 {
 	TMap<FString, T> Value;
 
+	/** Keys of Value are sorted */
+	bool bSorted;
+
 	FDataProperty()
+		: bSorted(true)
 	{
 		Value.Shrink();
 	}
@@ -362,7 +478,7 @@ struct FDataProperty<TMap<FString, T>> : public FAbstractDataProperty
 
 	virtual void Serialize(const UPsData* Instance, FPsDataSerializer* Serializer) override
 	{
-		FDataReflectionTools::FTypeSerializer<TMap<FString, T>>::Serialize(Instance, GetField(), Serializer, Get());
+		FDataReflectionTools::SerializeStatic<TMap<FString, T>>(Instance, GetField(), Serializer, GetSorted());
 	}
 
 	virtual void Deserialize(UPsData* Instance, FPsDataDeserializer* Deserializer) override
@@ -375,25 +491,123 @@ struct FDataProperty<TMap<FString, T>> : public FAbstractDataProperty
 		Set({}, Instance);
 	}
 
+	virtual TFunction<void(UPsData*)> Snapshot() override
+	{
+		const TMap<FString, T> OldValue = Value;
+		return [this, OldValue](UPsData* Instance) {
+			Set(OldValue, Instance);
+		};
+	}
+
+	virtual void CopyFrom(UPsData* Instance, const FAbstractDataProperty* Source) override
+	{
+		const FDataProperty* Other = static_cast<const FDataProperty*>(Source);
+		Value = Other->Value;
+		bSorted = Other->bSorted;
+	}
+
+	virtual SIZE_T GetAllocatedSize() const override
+	{
+		return Value.GetAllocatedSize();
+	}
+
 	TMap<FString, T>& Get()
 	{
 		return Value;
 	}
 
+	/** Map with sorted keys, sorts only after keys were added */
+	const TMap<FString, T>& GetSorted()
+	{
+		if (!bSorted)
+		{
+			Value.KeyStableSort([](const FString& A, const FString& B) {
+				return A < B;
+			});
+			bSorted = true;
+		}
+		return Value;
+	}
+
 	void Set(const TMap<FString, T>& NewValue, UPsData* Instance)
 	{
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataSet);
+
 		if (FDataReflectionTools::FTypeComparator<TMap<FString, T>>::Compare(Value, NewValue))
 		{
 			return;
 		}
 
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
 		Value = NewValue;
-		Value.KeyStableSort([](const FString& A, const FString& B) {
-			return A < B;
-		});
+		bSorted = false;
 
 		FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
 	}
+
+	void AddElement(const FString& Key, const T& Element, UPsData* Instance)
+	{
+		bool bChanging = false;
+		if (AddElementInternal(Key, Element, Instance, bChanging))
+		{
+			FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
+		}
+	}
+
+	void AppendElements(const TMap<FString, T>& Elements, UPsData* Instance)
+	{
+		bool bChanging = false;
+		bool bChange = false;
+		for (const auto& Pair : Elements)
+		{
+			bChange |= AddElementInternal(Pair.Key, Pair.Value, Instance, bChanging);
+		}
+
+		if (bChange)
+		{
+			FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
+		}
+	}
+
+	bool RemoveElement(const FString& Key, UPsData* Instance)
+	{
+		if (!Value.Contains(Key))
+		{
+			return false;
+		}
+
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		Value.Remove(Key);
+		FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
+		return true;
+	}
+
+private:
+	/** Add or replace element, bChanging tells if transaction already recorded the property */
+	bool AddElementInternal(const FString& Key, const T& Element, UPsData* Instance, bool& bChanging)
+	{
+		T* Find = Value.Find(Key);
+		if (Find && FDataReflectionTools::FTypeComparator<T>::Compare(*Find, Element))
+		{
+			return false;
+		}
+
+		if (!bChanging)
+		{
+			FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+			bChanging = true;
+		}
+
+		if (Find)
+		{
+			*Find = Element;
+			return true;
+		}
+
+		Value.Add(Key, Element);
+		bSorted = false;
+		return true;
+	}
 };
 
 /***********************************
@@ -414,7 +628,7 @@ struct FDataProperty<T*> : public FAbstractDataProperty
 
 	virtual void Serialize(const UPsData* Instance, FPsDataSerializer* Serializer) override
 	{
-		FDataReflectionTools::FTypeSerializer<T*>::Serialize(Instance, GetField(), Serializer, Get());
+		FDataReflectionTools::SerializeStatic<T*>(Instance, GetField(), Serializer, Get());
 	}
 
 	virtual void Deserialize(UPsData* Instance, FPsDataDeserializer* Deserializer) override
@@ -434,6 +648,31 @@ struct FDataProperty<T*> : public FAbstractDataProperty
 		}
 	}
 
+	virtual TFunction<void(UPsData*)> Snapshot() override
+	{
+		T* OldValue = Value;
+		return [this, OldValue](UPsData* Instance) {
+			Set(OldValue, Instance);
+		};
+	}
+
+	virtual void CopyFrom(UPsData* Instance, const FAbstractDataProperty* Source) override
+	{
+		if (Value)
+		{
+			FDataReflectionTools::FPsDataFriend::DetachClone(Instance, static_cast<UPsData*>(static_cast<void*>(Value)));
+			Value = nullptr;
+		}
+
+		const T* SourceValue = static_cast<const FDataProperty*>(Source)->Value;
+		if (SourceValue)
+		{
+			UPsData* Clone = FDataReflectionTools::FPsDataFriend::Clone(static_cast<const UPsData*>(static_cast<const void*>(SourceValue)), Instance);
+			FDataReflectionTools::FPsDataFriend::AttachClone(Instance, Clone, GetField()->Name, TEXT(""));
+			Value = static_cast<T*>(static_cast<void*>(Clone));
+		}
+	}
+
 	virtual void Allocate(UPsData* Instance) override
 	{
 		FPsDataAllocator Allocator(GetField()->Context->GetUE4Type(), Instance);
@@ -452,6 +691,8 @@ struct FDataProperty<T*> : public FAbstractDataProperty
 
 	void Set(T* NewValue, UPsData* Instance)
 	{
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataSet);
+
 		auto Field = GetField();
 		check(!Field->Meta.bStrict || NewValue != nullptr);
 
@@ -460,6 +701,8 @@ struct FDataProperty<T*> : public FAbstractDataProperty
 			return;
 		}
 
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+
 		if (Value)
 		{
 			FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, static_cast<UPsData*>(static_cast<void*>(Value)));
@@ -495,7 +738,7 @@ struct FDataProperty<TArray<T*>> : public FAbstractDataProperty
 
 	virtual void Serialize(const UPsData* Instance, FPsDataSerializer* Serializer) override
 	{
-		FDataReflectionTools::FTypeSerializer<TArray<T*>>::Serialize(Instance, GetField(), Serializer, Get());
+		FDataReflectionTools::SerializeStatic<TArray<T*>>(Instance, GetField(), Serializer, Get());
 	}
 
 	virtual void Deserialize(UPsData* Instance, FPsDataDeserializer* Deserializer) override
@@ -508,6 +751,37 @@ struct FDataProperty<TArray<T*>> : public FAbstractDataProperty
 		Set({}, Instance);
 	}
 
+	virtual TFunction<void(UPsData*)> Snapshot() override
+	{
+		const TArray<T*> OldValue = Value;
+		return [this, OldValue](UPsData* Instance) {
+			Set(OldValue, Instance);
+		};
+	}
+
+	virtual void CopyFrom(UPsData* Instance, const FAbstractDataProperty* Source) override
+	{
+		for (T* Element : Value)
+		{
+			FDataReflectionTools::FPsDataFriend::DetachClone(Instance, static_cast<UPsData*>(static_cast<void*>(Element)));
+		}
+
+		const TArray<T*>& SourceValue = static_cast<const FDataProperty*>(Source)->Value;
+		const FString& CollectionName = GetField()->Name;
+		Value.Reset(SourceValue.Num());
+		for (int32 i = 0; i < SourceValue.Num(); ++i)
+		{
+			UPsData* Clone = FDataReflectionTools::FPsDataFriend::Clone(static_cast<const UPsData*>(static_cast<const void*>(SourceValue[i])), Instance);
+			FDataReflectionTools::FPsDataFriend::AttachClone(Instance, Clone, FDataReflectionTools::FPsDataFriend::GetIndexName(i), CollectionName);
+			Value.Add(static_cast<T*>(static_cast<void*>(Clone)));
+		}
+	}
+
+	virtual SIZE_T GetAllocatedSize() const override
+	{
+		return Value.GetAllocatedSize();
+	}
+
 	TArray<T*>& Get()
 	{
 		return Value;
@@ -515,36 +789,154 @@ struct FDataProperty<TArray<T*>> : public FAbstractDataProperty
 
 	void Set(const TArray<T*>& NewValue, UPsData* Instance)
 	{
-		bool bChange = false;
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataSet);
+
+		if (Value == NewValue)
+		{
+			return;
+		}
+
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+
 		auto Field = GetField();
 
-		for (int32 i = 0; i < NewValue.Num(); ++i)
+		TSet<T*> NewElements;
+		NewElements.Reserve(NewValue.Num());
+		for (T* Element : NewValue)
 		{
-			if (NewValue[i]->GetParent() != Instance)
+			NewElements.Add(Element);
+		}
+
+		for (T* Element : Value)
+		{
+			if (!NewElements.Contains(Element))
 			{
-				FDataReflectionTools::FPsDataFriend::ChangeDataName(NewValue[i], FString::FromInt(i), Field->Name);
-				FDataReflectionTools::FPsDataFriend::AddChild(Instance, NewValue[i]);
-				bChange = true;
+				FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, Element);
 			}
 		}
 
-		for (int32 i = 0; i < Value.Num(); ++i)
+		for (int32 i = 0; i < NewValue.Num(); ++i)
 		{
-			if (!NewValue.Contains(Value[i])) //TODO: optimization
+			T* Element = NewValue[i];
+			if (Element->GetParent() != Instance)
 			{
-				FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, Value[i]);
-				bChange = true;
+				FDataReflectionTools::FPsDataFriend::ChangeDataName(Element, FDataReflectionTools::FPsDataFriend::GetIndexName(i), Field->Name);
+				FDataReflectionTools::FPsDataFriend::AddChild(Instance, Element);
+			}
+			else if (!Value.IsValidIndex(i) || Value[i] != Element)
+			{
+				FDataReflectionTools::FPsDataFriend::ChangeDataName(Element, FDataReflectionTools::FPsDataFriend::GetIndexName(i), Field->Name);
 			}
 		}
 
-		if (!bChange)
+		Value = NewValue;
+
+		FDataReflectionTools::FPsDataFriend::Changed(Instance, Field);
+	}
+
+	int32 AddElement(T* Element, UPsData* Instance)
+	{
+		auto Field = GetField();
+		if (!CanAttach(Element, Instance))
+		{
+			return INDEX_NONE;
+		}
+
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		const int32 Index = Value.Add(Element);
+
+		Attach(Element, Index, Instance);
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, Field, UPsDataEvent::ElementAddedId, Index);
+		return Index;
+	}
+
+	void InsertElement(T* Element, int32 Index, UPsData* Instance)
+	{
+		auto Field = GetField();
+		if (!CanAttach(Element, Instance))
 		{
 			return;
 		}
 
-		Value = NewValue;
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		Value.Insert(Element, Index);
 
-		FDataReflectionTools::FPsDataFriend::Changed(Instance, Field);
+		Attach(Element, Index, Instance);
+		UpdateNames(Index + 1);
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, Field, UPsDataEvent::ElementAddedId, Index);
+	}
+
+	void RemoveElementAt(int32 Index, UPsData* Instance, bool bAllowShrinking = false)
+	{
+		auto Field = GetField();
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, Value[Index]);
+		Value.RemoveAt(Index, 1, bAllowShrinking);
+
+		UpdateNames(Index);
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, Field, UPsDataEvent::ElementRemovedId, Index);
+	}
+
+	T* SetElement(T* Element, int32 Index, UPsData* Instance)
+	{
+		T* OldElement = Value[Index];
+		if (OldElement == Element)
+		{
+			return OldElement;
+		}
+
+		auto Field = GetField();
+		if (!CanAttach(Element, Instance))
+		{
+			return nullptr;
+		}
+
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, OldElement);
+		Value[Index] = Element;
+
+		Attach(Element, Index, Instance);
+		FDataReflectionTools::FPsDataFriend::ChangedElement(Instance, Field, UPsDataEvent::ElementChangedId, Index);
+		return OldElement;
+	}
+
+private:
+	/** Element can be added if it has no parent or is already an element of this array */
+	bool CanAttach(T* Element, UPsData* Instance) const
+	{
+		const UPsData* ElementParent = Element->GetParent();
+		if (ElementParent && ElementParent != Instance)
+		{
+			UE_LOG(LogData, Error, TEXT("Can't add \"%s\" to \"%s::%s\", it's already a child of \"%s\""), *Element->GetPathFromRoot(), *Instance->GetPathFromRoot(), *GetField()->Name, *ElementParent->GetPathFromRoot());
+			return false;
+		}
+
+		if (ElementParent && Element->GetCollectionKey() != GetField()->Name)
+		{
+			UE_LOG(LogData, Error, TEXT("Can't add \"%s\" to \"%s::%s\", it's already in \"%s\""), *Element->GetPathFromRoot(), *Instance->GetPathFromRoot(), *GetField()->Name, *Element->GetCollectionKey());
+			return false;
+		}
+		return true;
+	}
+
+	/** Name element by index and add it as child if it isn't a child yet */
+	void Attach(T* Element, int32 Index, UPsData* Instance)
+	{
+		FDataReflectionTools::FPsDataFriend::ChangeDataName(Element, FDataReflectionTools::FPsDataFriend::GetIndexName(Index), GetField()->Name);
+		if (Element->GetParent() != Instance)
+		{
+			FDataReflectionTools::FPsDataFriend::AddChild(Instance, Element);
+		}
+	}
+
+	/** Elements are named by index, so shifted elements have to be renamed */
+	void UpdateNames(int32 StartIndex)
+	{
+		auto Field = GetField();
+		for (int32 i = StartIndex; i < Value.Num(); ++i)
+		{
+			FDataReflectionTools::FPsDataFriend::ChangeDataName(Value[i], FDataReflectionTools::FPsDataFriend::GetIndexName(i), Field->Name);
+		}
 	}
 };
 
@@ -557,16 +949,34 @@ struct FDataProperty<TMap<FString, T*>> : public FAbstractDataProperty
 {
 	TMap<FString, T*> Value;
 
+	/** Keys of Value are sorted */
+	bool bSorted;
+
+	/** Incremented by owner on every change, validates links resolved through this map */
+	uint32 Revision;
+
 	FDataProperty()
+		: bSorted(true)
+		, Revision(0)
 	{
 		Value.Shrink();
 	}
 
 	virtual ~FDataProperty() {}
 
+	virtual uint32 GetRevision() const override
+	{
+		return Revision;
+	}
+
+	virtual void IncrementRevision() override
+	{
+		++Revision;
+	}
+
 	virtual void Serialize(const UPsData* Instance, FPsDataSerializer* Serializer) override
 	{
-		FDataReflectionTools::FTypeSerializer<TMap<FString, T*>>::Serialize(Instance, GetField(), Serializer, Get());
+		FDataReflectionTools::SerializeStatic<TMap<FString, T*>>(Instance, GetField(), Serializer, GetSorted());
 	}
 
 	virtual void Deserialize(UPsData* Instance, FPsDataDeserializer* Deserializer) override
@@ -579,48 +989,205 @@ struct FDataProperty<TMap<FString, T*>> : public FAbstractDataProperty
 		Set({}, Instance);
 	}
 
+	virtual TFunction<void(UPsData*)> Snapshot() override
+	{
+		const TMap<FString, T*> OldValue = Value;
+		return [this, OldValue](UPsData* Instance) {
+			Set(OldValue, Instance);
+		};
+	}
+
+	virtual void CopyFrom(UPsData* Instance, const FAbstractDataProperty* Source) override
+	{
+		for (const auto& Pair : Value)
+		{
+			FDataReflectionTools::FPsDataFriend::DetachClone(Instance, static_cast<UPsData*>(static_cast<void*>(Pair.Value)));
+		}
+
+		const FDataProperty* Other = static_cast<const FDataProperty*>(Source);
+		const FString& CollectionName = GetField()->Name;
+		Value.Reset();
+		Value.Reserve(Other->Value.Num());
+		for (const auto& Pair : Other->Value)
+		{
+			UPsData* Clone = FDataReflectionTools::FPsDataFriend::Clone(static_cast<const UPsData*>(static_cast<const void*>(Pair.Value)), Instance);
+			FDataReflectionTools::FPsDataFriend::AttachClone(Instance, Clone, Pair.Key, CollectionName);
+			Value.Add(Pair.Key, static_cast<T*>(static_cast<void*>(Clone)));
+		}
+		bSorted = Other->bSorted;
+		++Revision;
+	}
+
+	virtual SIZE_T GetAllocatedSize() const override
+	{
+		return Value.GetAllocatedSize();
+	}
+
 	TMap<FString, T*>& Get()
 	{
 		return Value;
 	}
 
+	/** Map with sorted keys, sorts only after keys were added */
+	const TMap<FString, T*>& GetSorted()
+	{
+		if (!bSorted)
+		{
+			Value.KeyStableSort([](const FString& A, const FString& B) {
+				return A < B;
+			});
+			bSorted = true;
+		}
+		return Value;
+	}
+
 	void Set(const TMap<FString, T*>& NewValue, UPsData* Instance)
 	{
-		bool bChange = false;
+		PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataSet);
+
+		bool bChange = Value.Num() != NewValue.Num();
+		for (auto It = NewValue.CreateConstIterator(); It && !bChange; ++It)
+		{
+			T* const* Find = Value.Find(It.Key());
+			bChange = !Find || *Find != It.Value();
+		}
+
+		if (!bChange)
+		{
+			return;
+		}
+
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+
 		auto Field = GetField();
 
+		TSet<T*> NewElements;
+		NewElements.Reserve(NewValue.Num());
 		for (auto& Pair : NewValue)
 		{
-			if (Pair.Value->GetParent() != Instance)
-			{
-				FDataReflectionTools::FPsDataFriend::ChangeDataName(Pair.Value, Pair.Key, Field->Name);
-				FDataReflectionTools::FPsDataFriend::AddChild(Instance, Pair.Value);
-				bChange = true;
-			}
+			NewElements.Add(Pair.Value);
 		}
 
 		for (auto& Pair : Value)
 		{
-			auto Find = NewValue.Find(Pair.Key);
-			if (!Find)
+			if (!NewElements.Contains(Pair.Value))
 			{
 				FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, Pair.Value);
-				bChange = true;
 			}
 		}
 
-		if (!bChange)
+		for (auto& Pair : NewValue)
 		{
-			return;
+			FDataReflectionTools::FPsDataFriend::ChangeDataName(Pair.Value, Pair.Key, Field->Name);
+			if (Pair.Value->GetParent() != Instance)
+			{
+				FDataReflectionTools::FPsDataFriend::AddChild(Instance, Pair.Value);
+			}
 		}
 
 		Value = NewValue;
-		Value.KeyStableSort([](const FString& A, const FString& B) {
-			return A < B;
-		});
+		bSorted = false;
 
 		FDataReflectionTools::FPsDataFriend::Changed(Instance, Field);
 	}
+
+	void AddElement(const FString& Key, T* Element, UPsData* Instance)
+	{
+		bool bChanging = false;
+		if (AddElementInternal(Key, Element, Instance, bChanging))
+		{
+			FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
+		}
+	}
+
+	void AppendElements(const TMap<FString, T*>& Elements, UPsData* Instance)
+	{
+		bool bChanging = false;
+		bool bChange = false;
+		for (const auto& Pair : Elements)
+		{
+			bChange |= AddElementInternal(Pair.Key, Pair.Value, Instance, bChanging);
+		}
+
+		if (bChange)
+		{
+			FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
+		}
+	}
+
+	bool RemoveElement(const FString& Key, UPsData* Instance)
+	{
+		T** Find = Value.Find(Key);
+		if (!Find)
+		{
+			return false;
+		}
+
+		FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+		FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, *Find);
+		Value.Remove(Key);
+		FDataReflectionTools::FPsDataFriend::Changed(Instance, GetField());
+		return true;
+	}
+
+private:
+	/** Add or replace element, bChanging tells if transaction already recorded the property */
+	bool AddElementInternal(const FString& Key, T* Element, UPsData* Instance, bool& bChanging)
+	{
+		T* const* Find = Value.Find(Key);
+		T* OldElement = Find ? *Find : nullptr;
+		if (OldElement == Element)
+		{
+			return false;
+		}
+
+		auto Field = GetField();
+		const UPsData* ElementParent = Element->GetParent();
+		if (ElementParent && ElementParent != Instance)
+		{
+			UE_LOG(LogData, Error, TEXT("Can't add \"%s\" to \"%s::%s\", it's already a child of \"%s\""), *Element->GetPathFromRoot(), *Instance->GetPathFromRoot(), *Field->Name, *ElementParent->GetPathFromRoot());
+			return false;
+		}
+
+		// Child of instance in other property would end up in two collections
+		if (ElementParent && Element->GetCollectionKey() != Field->Name)
+		{
+			UE_LOG(LogData, Error, TEXT("Can't add \"%s\" to \"%s::%s\", it's already in \"%s\""), *Element->GetPathFromRoot(), *Instance->GetPathFromRoot(), *Field->Name, *Element->GetCollectionKey());
+			return false;
+		}
+
+		if (!bChanging)
+		{
+			FDataReflectionTools::FPsDataFriend::Changing(Instance, this);
+			bChanging = true;
+		}
+
+		// Element moves from another key of this map
+		if (ElementParent)
+		{
+			const FString& OldKey = Element->GetDataKey();
+			if (Value.FindRef(OldKey) == Element)
+			{
+				Value.Remove(OldKey);
+			}
+		}
+
+		// Map is updated before old element is removed, so Removing listeners see the new state
+		Value.Add(Key, Element);
+		bSorted = false;
+
+		if (OldElement)
+		{
+			FDataReflectionTools::FPsDataFriend::RemoveChild(Instance, OldElement);
+		}
+
+		FDataReflectionTools::FPsDataFriend::ChangeDataName(Element, Key, Field->Name);
+		if (!ElementParent)
+		{
+			FDataReflectionTools::FPsDataFriend::AddChild(Instance, Element);
+		}
+		return true;
+	}
 };
 
 namespace FDataReflectionTools
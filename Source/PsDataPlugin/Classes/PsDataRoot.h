@@ -11,4 +11,49 @@ UCLASS(BlueprintType, Blueprintable)
 class PSDATAPLUGIN_API UPsDataRoot : public UPsData
 {
 	GENERATED_UCLASS_BODY()
+
+private:
+	friend struct FDataReflectionTools::FPsDataFriend;
+
+	/** Link index enabled */
+	bool bLinkIndex;
+
+	/** Linking data by link path and key */
+	TMap<FString, TMap<FString, TSet<UPsData*>>> LinkIndex;
+
+	/** Indexed link path and key for every linking data */
+	TMap<UPsData*, TArray<TPair<FString, FString>>> LinkIndexEntries;
+
+	/** Number of roots with enabled link index */
+	static int32 NumLinkIndices;
+
+	/***********************************
+	 * Reverse link index
+	 ***********************************/
+public:
+	/** Build reverse link index and keep it updated */
+	UFUNCTION(BlueprintCallable, Category = "PsData|Root")
+	void EnableLinkIndex();
+
+	/** Drop reverse link index */
+	UFUNCTION(BlueprintCallable, Category = "PsData|Root")
+	void DisableLinkIndex();
+
+	/** Is reverse link index enabled */
+	UFUNCTION(BlueprintCallable, Category = "PsData|Root")
+	bool IsLinkIndexEnabled() const;
+
+	/** Find data linked to key of collection by link path */
+	UFUNCTION(BlueprintCallable, Category = "PsData|Root")
+	TArray<UPsData*> FindLinkedBy(const FString& LinkPath, const FString& Key) const;
+
+private:
+	/** Index links of data */
+	void IndexLinks(UPsData* Data, bool bRecursive);
+
+	/** Remove links of data from index */
+	void UnindexLinks(UPsData* Data, bool bRecursive);
+
+protected:
+	virtual void BeginDestroy() override;
 };
@@ -0,0 +1,50 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+class UPsData;
+
+/***********************************
+ * Stats
+ ***********************************/
+
+/** Cycle stats of PsData hot paths, call counts are shown by "stat PsData" next to time */
+DECLARE_STATS_GROUP(TEXT("PsData"), STATGROUP_PsData, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_PsDataSerialize, STATGROUP_PsData, PSDATAPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Deserialize"), STAT_PsDataDeserialize, STATGROUP_PsData, PSDATAPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set"), STAT_PsDataSet, STATGROUP_PsData, PSDATAPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Broadcast"), STAT_PsDataBroadcast, STATGROUP_PsData, PSDATAPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Calculate hash"), STAT_PsDataCalculateHash, STATGROUP_PsData, PSDATAPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve link"), STAT_PsDataResolveLink, STATGROUP_PsData, PSDATAPLUGIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get by path"), STAT_PsDataGetByPath, STATGROUP_PsData, PSDATAPLUGIN_API);
+
+/** Stat cycle counter and Insights cpu scope, both are compiled out if stats and trace are disabled */
+#define PSDATA_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat);           \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+
+/***********************************
+ * Trace
+ ***********************************/
+
+/** Insights channel with broadcasted events, enable with -trace=PsData */
+UE_TRACE_CHANNEL_EXTERN(PsDataChannel, PSDATAPLUGIN_API)
+
+struct PSDATAPLUGIN_API FPsDataTrace
+{
+	/** Write broadcast event with data class and event type, use PSDATA_TRACE_BROADCAST */
+	static void Broadcast(const UPsData* Data, FName Type);
+};
+
+/** Trace broadcast, nothing is evaluated if channel is disabled */
+#define PSDATA_TRACE_BROADCAST(Data, Type)               \
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(PsDataChannel)) \
+	{                                                   \
+		FPsDataTrace::Broadcast(Data, Type);            \
+	}
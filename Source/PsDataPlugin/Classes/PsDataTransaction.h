@@ -0,0 +1,106 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPsData;
+struct FAbstractDataProperty;
+struct FDataField;
+
+namespace FDataReflectionTools
+{
+struct FPsDataFriend;
+} // namespace FDataReflectionTools
+
+/***********************************
+ * FPsDataTransaction
+ ***********************************/
+
+/**
+ * Batch of data changes. While transaction is active, field events and hash invalidation are delayed.
+ * On commit every (data, event type) pair is broadcasted once, bubbling reaches every parent once.
+ * Not finished transaction is committed in destructor. Nested transaction is merged into outer one.
+ */
+struct PSDATAPLUGIN_API FPsDataTransaction
+{
+	FPsDataTransaction();
+	~FPsDataTransaction();
+
+	FPsDataTransaction(const FPsDataTransaction&) = delete;
+	FPsDataTransaction& operator=(const FPsDataTransaction&) = delete;
+
+	/** Apply changes and broadcast events */
+	void Commit();
+
+	/** Restore values recorded before first change, events are dropped */
+	void Rollback();
+
+	/** Is transaction committed or rolled back */
+	bool IsFinished() const;
+
+	/** Innermost active transaction, nullptr if none */
+	static FPsDataTransaction* GetCurrent();
+
+private:
+	friend struct FDataReflectionTools::FPsDataFriend;
+
+	struct FRecord
+	{
+		TWeakObjectPtr<UPsData> Data;
+		const FAbstractDataProperty* Property;
+		TFunction<void(UPsData*)> Restore;
+	};
+
+	struct FChange
+	{
+		TWeakObjectPtr<UPsData> Data;
+		TSharedPtr<const FDataField> Field;
+	};
+
+	struct FElementChange
+	{
+		TWeakObjectPtr<UPsData> Data;
+		TSharedPtr<const FDataField> Field;
+		FName Type;
+		int32 Index;
+	};
+
+	/** Save value of property before first change */
+	void Record(UPsData* Data, FAbstractDataProperty* Property);
+
+	/** Field changed */
+	void Changed(UPsData* Data, const TSharedPtr<const FDataField>& Field);
+
+	/** Array element changed */
+	void ChangedElement(UPsData* Data, const TSharedPtr<const FDataField>& Field, FName Type, int32 Index);
+
+	/** Merge into outer transaction or flush */
+	void Finish(bool bBroadcast);
+
+	/** Drop hashes and broadcast coalesced events */
+	void Flush(bool bBroadcast);
+
+	/** Outer transaction */
+	FPsDataTransaction* Outer;
+
+	/** Recorded values */
+	TArray<FRecord> Records;
+	TSet<const FAbstractDataProperty*> RecordedProperties;
+
+	/** Changed fields in order of first change */
+	TArray<FChange> Changes;
+	TSet<TPair<const UPsData*, const FDataField*>> ChangedFields;
+
+	/** Element events in order */
+	TArray<FElementChange> ElementChanges;
+
+	/** Finished flag */
+	bool bFinished;
+
+	/** Rollback in progress */
+	bool bRestoring;
+
+	/** Innermost transaction */
+	static FPsDataTransaction* Current;
+};
@@ -31,6 +31,8 @@ enum class EBinaryTokens : uint8
 	Value_FString = 11,
 	Value_FName = 12,
 	Value_null = 13,
+	/** Object with class index and positional values, see FPsDataSnapshotSerializer */
+	SchemaObjectBegin = 14,
 };
 
 /***********************************
@@ -48,21 +50,25 @@ public:
 
 	TSharedRef<FPsDataOutputStream> GetOutputStream() const;
 
-	virtual void WriteKey(const FString& Key) override;
-	virtual void WriteArray() override;
-	virtual void WriteObject() override;
-	virtual void WriteValue(int32 Value) override;
-	virtual void WriteValue(int64 Value) override;
-	virtual void WriteValue(uint8 Value) override;
-	virtual void WriteValue(float Value) override;
-	virtual void WriteValue(bool Value) override;
-	virtual void WriteValue(const FString& Value) override;
-	virtual void WriteValue(const FName& Value) override;
+	/** Encode key token with alias for class plan */
+	static TArray<uint8> EncodeKey(const FString& Key);
+
+	virtual void WriteKey(const FString& Key) override final;
+	virtual void WriteFieldKey(const FPsDataClassPlanEntry& Entry) override final;
+	virtual void WriteArray() override final;
+	virtual void WriteObject() override final;
+	virtual void WriteValue(int32 Value) override final;
+	virtual void WriteValue(int64 Value) override final;
+	virtual void WriteValue(uint8 Value) override final;
+	virtual void WriteValue(float Value) override final;
+	virtual void WriteValue(bool Value) override final;
+	virtual void WriteValue(const FString& Value) override final;
+	virtual void WriteValue(const FName& Value) override final;
 	virtual void WriteValue(const UPsData* Value) override;
 
-	virtual void PopKey(const FString& Key) override;
-	virtual void PopArray() override;
-	virtual void PopObject() override;
+	virtual void PopKey(const FString& Key) override final;
+	virtual void PopArray() override final;
+	virtual void PopObject() override final;
 };
 
 /***********************************
@@ -78,7 +84,7 @@ public:
 	FPsDataBinaryDeserializer(TSharedRef<FPsDataInputStream> InInputStream);
 	virtual ~FPsDataBinaryDeserializer(){};
 
-private:
+protected:
 	bool ReadToken(EBinaryTokens Token);
 
 public:
@@ -0,0 +1,129 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "Serialize/PsDataSerialization.h"
+#include "Serialize/Stream/PsDataInputStream.h"
+#include "Serialize/Stream/PsDataOutputStream.h"
+
+#include "CoreMinimal.h"
+
+class UPsData;
+
+/***********************************
+ * EPsDataColumnType
+ ***********************************/
+
+enum class EPsDataColumnType : uint8
+{
+	Int32 = 0,
+	Int64 = 1,
+	Float = 2,
+	Bool = 3,
+	Uint8 = 4,
+	String = 5,
+	Name = 6,
+	/** Any other type, each row is stored as binary serializer output */
+	Binary = 7,
+};
+
+/***********************************
+ * FPsDataColumn
+ ***********************************/
+
+struct PSDATAPLUGIN_API FPsDataColumn
+{
+	/** Serialized field name */
+	FString Alias;
+
+	/** Type hash of field */
+	uint32 TypeHash;
+
+	/** Storage type */
+	EPsDataColumnType Type;
+
+	/** Values of Int32 column */
+	TArray<int32> Int32Values;
+
+	/** Values of Int64 column */
+	TArray<int64> Int64Values;
+
+	/** Values of Float column */
+	TArray<float> FloatValues;
+
+	/** Values of Bool and Uint8 columns */
+	TArray<uint8> ByteValues;
+
+	/** Pool offsets of String, Name and Binary columns, row i is [Offsets[i], Offsets[i + 1]) */
+	TArray<int32> Offsets;
+
+	/** String pool */
+	TArray<TCHAR> Chars;
+
+	/** Binary pool */
+	TArray<uint8> Bytes;
+
+	FPsDataColumn();
+	FPsDataColumn(const FString& Alias, uint32 TypeHash, EPsDataColumnType Type);
+
+	/** Number of rows */
+	int32 Num() const;
+
+	/** Append string to pool */
+	void AddString(const FString& Value);
+
+	/** Get string from pool */
+	FString GetString(int32 Row) const;
+
+	/** Append bytes to pool */
+	void AddBytes(const TArray<uint8>& Value);
+
+	/** Get bytes from pool */
+	TArray<uint8> GetBytes(int32 Row) const;
+};
+
+/***********************************
+ * FPsDataColumnarTable
+ ***********************************/
+
+struct PSDATAPLUGIN_API FPsDataColumnarTable
+{
+	/** Class of every row */
+	UClass* Class;
+
+	/** Collection keys */
+	FPsDataColumn Keys;
+
+	/** One column per field */
+	TArray<FPsDataColumn> Columns;
+
+	FPsDataColumnarTable();
+
+	/** Number of rows */
+	int32 Num() const;
+
+	/** Find column by serialized field name */
+	const FPsDataColumn* FindColumn(const FString& Alias) const;
+};
+
+/***********************************
+ * FPsDataColumnarSerializer
+ ***********************************/
+
+struct PSDATAPLUGIN_API FPsDataColumnarSerializer
+{
+	/** Build columns from collection, every element must have the same class */
+	static bool Export(const TMap<FString, UPsData*>& Collection, UClass* Class, FPsDataColumnarTable& OutTable);
+
+	/** Build columns from map collection property of instance */
+	static bool Export(UPsData* Instance, int32 FieldHash, FPsDataColumnarTable& OutTable);
+
+	/** Replace map collection property of instance with rows from columns */
+	static bool Import(const FPsDataColumnarTable& Table, UPsData* Instance, int32 FieldHash);
+
+	/** Write table to stream */
+	static void Write(const FPsDataColumnarTable& Table, TSharedRef<FPsDataOutputStream> OutputStream);
+
+	/** Read table from stream */
+	static bool Read(TSharedRef<FPsDataInputStream> InputStream, FPsDataColumnarTable& OutTable);
+};
@@ -33,21 +33,25 @@ private:
 	void AppendValueSpace();
 
 public:
-	virtual void WriteKey(const FString& Key) override;
-	virtual void WriteArray() override;
-	virtual void WriteObject() override;
-	virtual void WriteValue(int32 Value) override;
-	virtual void WriteValue(int64 Value) override;
-	virtual void WriteValue(uint8 Value) override;
-	virtual void WriteValue(float Value) override;
-	virtual void WriteValue(bool Value) override;
-	virtual void WriteValue(const FString& Value) override;
-	virtual void WriteValue(const FName& Value) override;
+	/** Encode quoted alias with colon for class plan */
+	static FString EncodeKey(const FString& Key);
+
+	virtual void WriteKey(const FString& Key) override final;
+	virtual void WriteFieldKey(const FPsDataClassPlanEntry& Entry) override final;
+	virtual void WriteArray() override final;
+	virtual void WriteObject() override final;
+	virtual void WriteValue(int32 Value) override final;
+	virtual void WriteValue(int64 Value) override final;
+	virtual void WriteValue(uint8 Value) override final;
+	virtual void WriteValue(float Value) override final;
+	virtual void WriteValue(bool Value) override final;
+	virtual void WriteValue(const FString& Value) override final;
+	virtual void WriteValue(const FName& Value) override final;
 	virtual void WriteValue(const UPsData* Value) override;
 
-	virtual void PopKey(const FString& Key) override;
-	virtual void PopArray() override;
-	virtual void PopObject() override;
+	virtual void PopKey(const FString& Key) override final;
+	virtual void PopArray() override final;
+	virtual void PopObject() override final;
 };
 
 UENUM()
@@ -0,0 +1,113 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "Serialize/PsDataSerialization.h"
+
+#include "CoreMinimal.h"
+
+class UPsData;
+
+/***********************************
+ * FPsDataMsgPackSerializer
+ ***********************************/
+
+struct PSDATAPLUGIN_API FPsDataMsgPackSerializer : public FPsDataSerializer
+{
+public:
+	FPsDataMsgPackSerializer();
+	virtual ~FPsDataMsgPackSerializer(){};
+
+	TArray<uint8> Buffer;
+
+private:
+	struct FContainer
+	{
+		int32 Offset;
+		int32 Count;
+		bool bMap;
+	};
+
+	TArray<FContainer> Stack;
+
+	/** Unused bytes of reserved container headers, removed in one pass when root container is closed */
+	TArray<TPair<int32, int32>> Gaps;
+
+	void AddElement();
+	void WriteContainer(bool bMap);
+	void PopContainer(bool bMap);
+	void RemoveGaps();
+	void WriteBigEndian(uint64 Value, int32 NumBytes);
+	void WriteInteger(int64 Value);
+	void WriteString(const FString& Value);
+
+public:
+	virtual void WriteKey(const FString& Key) override final;
+	virtual void WriteArray() override final;
+	virtual void WriteObject() override final;
+	virtual void WriteValue(int32 Value) override final;
+	virtual void WriteValue(int64 Value) override final;
+	virtual void WriteValue(uint8 Value) override final;
+	virtual void WriteValue(float Value) override final;
+	virtual void WriteValue(bool Value) override final;
+	virtual void WriteValue(const FString& Value) override final;
+	virtual void WriteValue(const FName& Value) override final;
+	virtual void WriteValue(const UPsData* Value) override;
+
+	virtual void PopKey(const FString& Key) override final;
+	virtual void PopArray() override final;
+	virtual void PopObject() override final;
+};
+
+/***********************************
+ * FPsDataMsgPackDeserializer
+ ***********************************/
+
+struct PSDATAPLUGIN_API FPsDataMsgPackDeserializer : public FPsDataDeserializer
+{
+public:
+	/** Deserializer owns the buffer, pass it with MoveTemp to avoid copy */
+	FPsDataMsgPackDeserializer(TArray<uint8> InBuffer);
+	virtual ~FPsDataMsgPackDeserializer(){};
+
+private:
+	TArray<uint8> Buffer;
+	int32 Position;
+
+	/** Elements left in opened containers */
+	TArray<int32> Stack;
+
+	/** Value positions of read keys, value is skipped on pop if it was not read */
+	TArray<int32> ValuePositions;
+
+	bool CanRead(int32 NumBytes) const;
+	uint64 ReadBigEndian(int32 NumBytes);
+	bool ReadContainer(bool bMap);
+	bool ReadInteger(int64& OutValue);
+	bool ReadString(FString& OutValue);
+
+	/** Move position by NumBytes, jump to the end if buffer is shorter */
+	bool Skip(uint64 NumBytes);
+
+	/** Skip next value with nested values, malformed input moves position to the end */
+	void SkipValue();
+
+public:
+	virtual bool ReadKey(FString& OutKey) override;
+	virtual bool ReadIndex() override;
+	virtual bool ReadArray() override;
+	virtual bool ReadObject() override;
+	virtual bool ReadValue(int32& OutValue) override;
+	virtual bool ReadValue(int64& OutValue) override;
+	virtual bool ReadValue(uint8& OutValue) override;
+	virtual bool ReadValue(float& OutValue) override;
+	virtual bool ReadValue(bool& OutValue) override;
+	virtual bool ReadValue(FString& OutValue) override;
+	virtual bool ReadValue(FName& OutValue) override;
+	virtual bool ReadValue(UPsData*& OutValue, FPsDataAllocator Allocator) override;
+
+	virtual void PopKey(const FString& Key) override;
+	virtual void PopIndex() override;
+	virtual void PopArray() override;
+	virtual void PopObject() override;
+};
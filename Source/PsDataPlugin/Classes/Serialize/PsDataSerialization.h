@@ -26,6 +26,61 @@ struct PSDATAPLUGIN_API FPsDataAllocator
 	UPsData* operator()() const;
 };
 
+/***********************************
+ * FPsDataClassPlan
+ ***********************************/
+
+struct PSDATAPLUGIN_API FPsDataClassPlanEntry
+{
+	/** Serialized field name */
+	FString Alias;
+
+	/** Key token with alias as written by FPsDataBinarySerializer */
+	TArray<uint8> BinaryKey;
+
+	/** Quoted alias with colon as written by FPsDataFastJsonSerializer */
+	FString JsonKey;
+
+	/** Property index */
+	int32 Index;
+
+	/** Type hash */
+	uint32 TypeHash;
+
+	/** Field */
+	const FDataField* Field;
+
+	FPsDataClassPlanEntry();
+};
+
+struct PSDATAPLUGIN_API FPsDataClassPlan
+{
+	/** Fields in serialization order */
+	TArray<FPsDataClassPlanEntry> Entries;
+
+	/** Entry index by alias, used when hint misses */
+	TMap<FString, int32> EntryIndices;
+
+	/** Find entry index by alias, entry at Hint is checked first */
+	int32 Find(const FString& Alias, int32 Hint = 0) const;
+};
+
+/***********************************
+ * EPsDataSerializerType
+ ***********************************/
+
+enum class EPsDataSerializerType : uint8
+{
+	/** Unknown serializer, called through virtual interface only */
+	Custom = 0,
+	/** FPsDataBinarySerializer or derived */
+	Binary = 1,
+	/** FPsDataFastJsonSerializer */
+	FastJson = 2,
+	/** FPsDataMsgPackSerializer */
+	MsgPack = 3,
+};
+
 /***********************************
  * FPsDataSerializer
  ***********************************/
@@ -35,7 +90,18 @@ struct PSDATAPLUGIN_API FPsDataSerializer
 public:
 	FPsDataSerializer();
 
+protected:
+	FPsDataSerializer(EPsDataSerializerType InType);
+
+private:
+	EPsDataSerializerType Type;
+
+public:
+	/** Serializer type used for static dispatch in properties */
+	EPsDataSerializerType GetType() const { return Type; }
+
 	virtual void WriteKey(const FString& Key) = 0;
+	virtual void WriteFieldKey(const FPsDataClassPlanEntry& Entry);
 	virtual void WriteArray() = 0;
 	virtual void WriteObject() = 0;
 	virtual void WriteValue(int32 Value) = 0;
@@ -0,0 +1,78 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#pragma once
+
+#include "Serialize/PsDataBinarySerialization.h"
+#include "Serialize/Stream/PsDataBufferOutputStream.h"
+
+#include "CoreMinimal.h"
+
+class UPsData;
+
+/***********************************
+ * FPsDataSnapshotSerializer
+ ***********************************/
+
+/**
+ * Binary serializer with schema header. Objects are written without keys,
+ * values follow the class plan order described in the header.
+ * Call Finish after DataSerialize to write header and data to output stream.
+ */
+struct PSDATAPLUGIN_API FPsDataSnapshotSerializer : public FPsDataBinarySerializer
+{
+public:
+	FPsDataSnapshotSerializer(TSharedRef<FPsDataOutputStream> InOutputStream);
+	virtual ~FPsDataSnapshotSerializer(){};
+
+	/** Write header and serialized data */
+	void Finish();
+
+private:
+	TSharedRef<FPsDataOutputStream> TargetStream;
+	TSharedRef<FPsDataBufferOutputStream> BodyStream;
+
+	TMap<const UClass*, uint32> ClassIndices;
+	TArray<const UClass*> Classes;
+
+	uint32 GetClassIndex(const UClass* Class);
+
+public:
+	virtual void WriteValue(const UPsData* Value) override;
+};
+
+/***********************************
+ * FPsDataSnapshotDeserializer
+ ***********************************/
+
+struct PSDATAPLUGIN_API FPsDataSnapshotDeserializer : public FPsDataBinaryDeserializer
+{
+public:
+	FPsDataSnapshotDeserializer(TSharedRef<FPsDataInputStream> InInputStream);
+	virtual ~FPsDataSnapshotDeserializer(){};
+
+	/** Header was read successfully */
+	bool IsValid() const;
+
+private:
+	struct FClassSchema
+	{
+		FString ClassPath;
+		TArray<FString> Aliases;
+		TArray<uint32> TypeHashes;
+
+		/** Class for which remap was built */
+		const UClass* RemapClass;
+
+		/** Property index for every field of header, INDEX_NONE is skipped */
+		TArray<int32> Remap;
+	};
+
+	TArray<FClassSchema> Schema;
+	bool bValid;
+
+	const TArray<int32>& GetRemap(FClassSchema& ClassSchema, const UClass* Class);
+	void SkipValue();
+
+public:
+	virtual bool ReadValue(UPsData*& OutValue, FPsDataAllocator Allocator) override;
+};
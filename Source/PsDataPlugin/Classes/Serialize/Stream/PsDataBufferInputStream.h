@@ -31,6 +31,7 @@ public:
 	virtual TCHAR ReadTCHAR() override;
 	virtual FString ReadString() override;
 	virtual bool HasData() override;
+	virtual int32 Remaining() override;
 	virtual void ShiftBack() override;
 
 protected:
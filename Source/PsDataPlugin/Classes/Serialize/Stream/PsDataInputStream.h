@@ -20,5 +20,6 @@ struct PSDATAPLUGIN_API FPsDataInputStream
 	virtual TCHAR ReadTCHAR() = 0;
 	virtual FString ReadString() = 0;
 	virtual bool HasData() = 0;
+	virtual int32 Remaining() = 0;
 	virtual void ShiftBack() = 0;
 };
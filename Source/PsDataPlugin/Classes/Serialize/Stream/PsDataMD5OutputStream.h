@@ -51,4 +51,5 @@ public:
 	virtual void WriteBool(bool Value) override;
 	virtual void WriteTCHAR(TCHAR Value) override;
 	virtual void WriteString(const FString& Value) override;
+	virtual void WriteBuffer(const TArray<uint8>& Value) override;
 };
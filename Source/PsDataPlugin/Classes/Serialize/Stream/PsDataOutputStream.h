@@ -19,4 +19,13 @@ struct PSDATAPLUGIN_API FPsDataOutputStream
 	virtual void WriteBool(bool Value) = 0;
 	virtual void WriteTCHAR(TCHAR Value) = 0;
 	virtual void WriteString(const FString& Value) = 0;
+
+	/** Write raw bytes, override when stream can copy them at once */
+	virtual void WriteBuffer(const TArray<uint8>& Value)
+	{
+		for (const uint8 Byte : Value)
+		{
+			WriteUint8(Byte);
+		}
+	}
 };
@@ -70,7 +70,7 @@ struct FDataTypeContext<TMap<FString, FString>> : public FDataTypeContextExtende
 namespace FDataReflectionTools
 {
 template <>
-struct FTypeSerializer<FString> : public FTypeSerializerExtended<FString, UPsDataFStringLibrary>
+struct FTypeSerializer<FString> : public FTypeSerializerDirect<FString, UPsDataFStringLibrary>
 {
 };
 
@@ -76,7 +76,7 @@ struct FTypeDefault<bool>
 };
 
 template <>
-struct FTypeSerializer<bool> : public FTypeSerializerExtended<bool, UPsDataBoolLibrary>
+struct FTypeSerializer<bool> : public FTypeSerializerDirect<bool, UPsDataBoolLibrary>
 {
 };
 
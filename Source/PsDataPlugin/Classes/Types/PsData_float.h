@@ -76,7 +76,7 @@ struct FTypeDefault<float>
 };
 
 template <>
-struct FTypeSerializer<float> : public FTypeSerializerExtended<float, UPsDataFloatLibrary>
+struct FTypeSerializer<float> : public FTypeSerializerDirect<float, UPsDataFloatLibrary>
 {
 };
 
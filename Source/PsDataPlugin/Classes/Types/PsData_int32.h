@@ -76,7 +76,7 @@ struct FTypeDefault<int32>
 };
 
 template <>
-struct FTypeSerializer<int32> : public FTypeSerializerExtended<int32, UPsDataInt32Library>
+struct FTypeSerializer<int32> : public FTypeSerializerDirect<int32, UPsDataInt32Library>
 {
 };
 
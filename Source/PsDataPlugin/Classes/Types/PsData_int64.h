@@ -76,7 +76,7 @@ struct FTypeDefault<int64>
 };
 
 template <>
-struct FTypeSerializer<int64> : public FTypeSerializerExtended<int64, UPsDataInt64Library>
+struct FTypeSerializer<int64> : public FTypeSerializerDirect<int64, UPsDataInt64Library>
 {
 };
 
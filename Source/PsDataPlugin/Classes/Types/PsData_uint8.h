@@ -76,7 +76,7 @@ struct FTypeDefault<uint8>
 };
 
 template <>
-struct FTypeSerializer<uint8> : public FTypeSerializerExtended<uint8, UPsDataUint8Library>
+struct FTypeSerializer<uint8> : public FTypeSerializerDirect<uint8, UPsDataUint8Library>
 {
 };
 
@@ -0,0 +1,121 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "Collection/PsDataBlueprintQuery.h"
+
+#include "Collection/PsDataBlueprintArrayProxy.h"
+#include "Collection/PsDataBlueprintMapProxy.h"
+
+UPsDataBlueprintQuery::UPsDataBlueprintQuery(const class FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Query()
+{
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::CreateQuery(TSubclassOf<UPsData> Class)
+{
+	UPsDataBlueprintQuery* Result = NewObject<UPsDataBlueprintQuery>();
+	Result->Query = FPsDataQuery(Class.Get());
+	return Result;
+}
+
+const FPsDataQuery& UPsDataBlueprintQuery::GetQuery() const
+{
+	return Query;
+}
+
+bool UPsDataBlueprintQuery::IsValid() const
+{
+	return Query.IsValid();
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::WhereInt(const FString& FieldName, EPsDataQueryOperator Operator, int32 Value)
+{
+	Query.Where(FieldName, Operator, Value);
+	return this;
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::WhereFloat(const FString& FieldName, EPsDataQueryOperator Operator, float Value)
+{
+	Query.Where(FieldName, Operator, Value);
+	return this;
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::WhereBool(const FString& FieldName, EPsDataQueryOperator Operator, bool Value)
+{
+	Query.Where(FieldName, Operator, Value);
+	return this;
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::WhereString(const FString& FieldName, EPsDataQueryOperator Operator, const FString& Value)
+{
+	Query.Where(FieldName, Operator, Value);
+	return this;
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::OrderBy(const FString& FieldName, bool bDescending)
+{
+	Query.OrderBy(FieldName, bDescending);
+	return this;
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::Limit(int32 Count)
+{
+	Query.Limit(Count);
+	return this;
+}
+
+UPsDataBlueprintQuery* UPsDataBlueprintQuery::Select(const FString& FieldName)
+{
+	Query.Select(FieldName);
+	return this;
+}
+
+TArray<UPsData*> UPsDataBlueprintQuery::ExecuteArray(UPsDataBlueprintArrayProxy* Proxy) const
+{
+	if (Proxy == nullptr || !Proxy->IsValid())
+	{
+		return {};
+	}
+
+	TArray<UPsData*> Result;
+	for (const UPsData* Data : Proxy->GetProxy().Query(Query))
+	{
+		Result.Add(const_cast<UPsData*>(Data));
+	}
+	return Result;
+}
+
+TArray<UPsData*> UPsDataBlueprintQuery::ExecuteMap(UPsDataBlueprintMapProxy* Proxy) const
+{
+	if (Proxy == nullptr || !Proxy->IsValid())
+	{
+		return {};
+	}
+
+	TArray<UPsData*> Result;
+	for (const UPsData* Data : Proxy->GetProxy().Query(Query))
+	{
+		Result.Add(const_cast<UPsData*>(Data));
+	}
+	return Result;
+}
+
+TArray<FString> UPsDataBlueprintQuery::ProjectToStrings(const TArray<UPsData*>& Data) const
+{
+	TArray<FString> Result;
+	for (const FPsDataIndexKey& Key : Query.Project(Data))
+	{
+		Result.Add(Key.bString ? Key.String : FString::SanitizeFloat(Key.Number, 0));
+	}
+	return Result;
+}
+
+TArray<float> UPsDataBlueprintQuery::ProjectToFloats(const TArray<UPsData*>& Data) const
+{
+	TArray<float> Result;
+	for (const FPsDataIndexKey& Key : Query.Project(Data))
+	{
+		Result.Add(Key.bString ? FCString::Atof(*Key.String) : static_cast<float>(Key.Number));
+	}
+	return Result;
+}
@@ -0,0 +1,406 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "Collection/PsDataCollectionIndex.h"
+
+#include "PsData.h"
+#include "PsDataCore.h"
+#include "Types/PsData_FName.h"
+#include "Types/PsData_FString.h"
+#include "Types/PsData_UPsData.h"
+#include "Types/PsData_bool.h"
+#include "Types/PsData_float.h"
+#include "Types/PsData_int32.h"
+#include "Types/PsData_int64.h"
+#include "Types/PsData_uint8.h"
+
+#include "Algo/BinarySearch.h"
+
+namespace PsDataCollectionIndex
+{
+template <typename T>
+FPsDataIndexKey ReadKey(UPsData* Data, const TSharedPtr<const FDataField>& Field)
+{
+	T* ValuePtr = nullptr;
+	FDataReflectionTools::UnsafeGet<T>(Data, Field, ValuePtr);
+	return FPsDataIndexKey(*ValuePtr);
+}
+} // namespace PsDataCollectionIndex
+
+/***********************************
+ * FPsDataIndexKey
+ ***********************************/
+
+FPsDataIndexKey::FPsDataIndexKey()
+	: bString(false)
+	, Number(0.0)
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(int32 Value)
+	: bString(false)
+	, Number(static_cast<double>(Value))
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(int64 Value)
+	: bString(false)
+	, Number(static_cast<double>(Value))
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(uint8 Value)
+	: bString(false)
+	, Number(static_cast<double>(Value))
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(float Value)
+	: bString(false)
+	, Number(static_cast<double>(Value))
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(bool Value)
+	: bString(false)
+	, Number(Value ? 1.0 : 0.0)
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(const FString& Value)
+	: bString(true)
+	, Number(0.0)
+	, String(Value)
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(const TCHAR* Value)
+	: bString(true)
+	, Number(0.0)
+	, String(Value)
+{
+}
+
+FPsDataIndexKey::FPsDataIndexKey(const FName& Value)
+	: bString(true)
+	, Number(0.0)
+	, String(Value == NAME_None ? FString() : Value.ToString())
+{
+}
+
+FPsDataIndexKey::FReader FPsDataIndexKey::GetReader(const TSharedPtr<const FDataField>& Field)
+{
+	const FAbstractDataTypeContext* Context = Field->Context;
+	if (Context->IsContainer())
+	{
+		return nullptr;
+	}
+
+	if (Context->IsEnum())
+	{
+		return &PsDataCollectionIndex::ReadKey<uint8>;
+	}
+
+	const uint32 Hash = Context->GetHash();
+	if (Hash == FDataReflectionTools::FType<int32>::Hash())
+	{
+		return &PsDataCollectionIndex::ReadKey<int32>;
+	}
+	else if (Hash == FDataReflectionTools::FType<int64>::Hash())
+	{
+		return &PsDataCollectionIndex::ReadKey<int64>;
+	}
+	else if (Hash == FDataReflectionTools::FType<float>::Hash())
+	{
+		return &PsDataCollectionIndex::ReadKey<float>;
+	}
+	else if (Hash == FDataReflectionTools::FType<bool>::Hash())
+	{
+		return &PsDataCollectionIndex::ReadKey<bool>;
+	}
+	else if (Hash == FDataReflectionTools::FType<uint8>::Hash())
+	{
+		return &PsDataCollectionIndex::ReadKey<uint8>;
+	}
+	else if (Hash == FDataReflectionTools::FType<FString>::Hash())
+	{
+		return &PsDataCollectionIndex::ReadKey<FString>;
+	}
+	else if (Hash == FDataReflectionTools::FType<FName>::Hash())
+	{
+		return &PsDataCollectionIndex::ReadKey<FName>;
+	}
+
+	return nullptr;
+}
+
+bool FPsDataIndexKey::Read(UPsData* Data, const TSharedPtr<const FDataField>& Field, FPsDataIndexKey& OutKey)
+{
+	if (FReader Reader = GetReader(Field))
+	{
+		OutKey = Reader(Data, Field);
+		return true;
+	}
+	return false;
+}
+
+bool FPsDataIndexKey::operator==(const FPsDataIndexKey& Other) const
+{
+	if (bString != Other.bString)
+	{
+		return false;
+	}
+	return bString ? String == Other.String : Number == Other.Number;
+}
+
+bool FPsDataIndexKey::operator<(const FPsDataIndexKey& Other) const
+{
+	if (bString != Other.bString)
+	{
+		return !bString;
+	}
+	return bString ? String < Other.String : Number < Other.Number;
+}
+
+/***********************************
+ * FPsDataFieldIndex
+ ***********************************/
+
+FPsDataFieldIndex::FPsDataFieldIndex(const TSharedPtr<const FDataField>& InField)
+	: Field(InField)
+	, bOrderedDirty(false)
+{
+}
+
+const TSharedPtr<const FDataField>& FPsDataFieldIndex::GetField() const
+{
+	return Field;
+}
+
+void FPsDataFieldIndex::Add(UPsData* Data)
+{
+	FPsDataIndexKey Key;
+	if (Data && !Keys.Contains(Data) && FPsDataIndexKey::Read(Data, Field, Key))
+	{
+		Hash.FindOrAdd(Key).Add(Data);
+		Keys.Add(Data, MoveTemp(Key));
+		bOrderedDirty = true;
+	}
+}
+
+void FPsDataFieldIndex::Remove(UPsData* Data)
+{
+	FPsDataIndexKey Key;
+	if (!Keys.RemoveAndCopyValue(Data, Key))
+	{
+		return;
+	}
+
+	if (TSet<UPsData*>* Find = Hash.Find(Key))
+	{
+		Find->Remove(Data);
+		if (Find->Num() == 0)
+		{
+			Hash.Remove(Key);
+		}
+	}
+
+	bOrderedDirty = true;
+}
+
+void FPsDataFieldIndex::Update(UPsData* Data)
+{
+	const FPsDataIndexKey* OldKey = Keys.Find(Data);
+	if (!OldKey)
+	{
+		return;
+	}
+
+	FPsDataIndexKey Key;
+	if (FPsDataIndexKey::Read(Data, Field, Key) && Key == *OldKey)
+	{
+		return;
+	}
+
+	Remove(Data);
+	Add(Data);
+}
+
+void FPsDataFieldIndex::Build(const TArray<UPsData*>& Elements)
+{
+	Keys.Reset();
+	Hash.Reset();
+	Ordered.Reset();
+	bOrderedDirty = true;
+
+	FPsDataIndexKey::FReader Reader = FPsDataIndexKey::GetReader(Field);
+	if (!Reader)
+	{
+		return;
+	}
+
+	for (UPsData* Data : Elements)
+	{
+		if (Data && !Keys.Contains(Data))
+		{
+			FPsDataIndexKey Key = Reader(Data, Field);
+			Hash.FindOrAdd(Key).Add(Data);
+			Keys.Add(Data, MoveTemp(Key));
+		}
+	}
+}
+
+void FPsDataFieldIndex::Find(const FPsDataIndexKey& Key, TArray<UPsData*>& OutData) const
+{
+	if (const TSet<UPsData*>* Find = Hash.Find(Key))
+	{
+		OutData.Reserve(OutData.Num() + Find->Num());
+		for (UPsData* Data : *Find)
+		{
+			OutData.Add(Data);
+		}
+	}
+}
+
+void FPsDataFieldIndex::FindRange(const FPsDataIndexKey& Min, const FPsDataIndexKey& Max, TArray<UPsData*>& OutData) const
+{
+	UpdateOrdered();
+
+	const int32 First = Algo::LowerBoundBy(Ordered, Min, [](const TPair<FPsDataIndexKey, UPsData*>& Pair) -> const FPsDataIndexKey& {
+		return Pair.Key;
+	});
+
+	for (int32 i = First; i < Ordered.Num() && !(Max < Ordered[i].Key); ++i)
+	{
+		OutData.Add(Ordered[i].Value);
+	}
+}
+
+void FPsDataFieldIndex::UpdateOrdered() const
+{
+	if (!bOrderedDirty)
+	{
+		return;
+	}
+
+	// Sorting once per query instead of shifting the array on every change keeps bulk edits linear
+	bOrderedDirty = false;
+	Ordered.Reset(Keys.Num());
+	for (const auto& Pair : Keys)
+	{
+		Ordered.Emplace(Pair.Value, Pair.Key);
+	}
+
+	Ordered.Sort([](const TPair<FPsDataIndexKey, UPsData*>& A, const TPair<FPsDataIndexKey, UPsData*>& B) {
+		return A.Key < B.Key;
+	});
+}
+
+/***********************************
+ * FPsDataCollectionIndex
+ ***********************************/
+
+FPsDataCollectionIndex::FPsDataCollectionIndex(UPsData* InOwner, const TSharedPtr<const FDataField>& InCollectionField)
+	: Owner(InOwner)
+	, CollectionField(InCollectionField)
+	, bDirty(true)
+{
+	check(CollectionField->Context->IsContainer() && CollectionField->Context->IsData());
+
+	UClass* ElementClass = Cast<UClass>(CollectionField->Context->GetUE4Type());
+	for (const auto& Pair : FDataReflection::GetFields(ElementClass))
+	{
+		if (Pair.Value->Meta.bIndex)
+		{
+			FieldIndices.Emplace(Pair.Value);
+		}
+	}
+}
+
+void FPsDataCollectionIndex::Add(UPsData* Data)
+{
+	if (bDirty)
+	{
+		return;
+	}
+
+	for (FPsDataFieldIndex& FieldIndex : FieldIndices)
+	{
+		FieldIndex.Add(Data);
+	}
+}
+
+void FPsDataCollectionIndex::Remove(UPsData* Data)
+{
+	if (bDirty)
+	{
+		return;
+	}
+
+	for (FPsDataFieldIndex& FieldIndex : FieldIndices)
+	{
+		FieldIndex.Remove(Data);
+	}
+}
+
+void FPsDataCollectionIndex::Update(UPsData* Data, const TSharedPtr<const FDataField>& Field)
+{
+	if (bDirty)
+	{
+		return;
+	}
+
+	for (FPsDataFieldIndex& FieldIndex : FieldIndices)
+	{
+		if (FieldIndex.GetField() == Field)
+		{
+			FieldIndex.Update(Data);
+			return;
+		}
+	}
+}
+
+const FPsDataFieldIndex* FPsDataCollectionIndex::GetFieldIndex(int32 FieldHash)
+{
+	for (const FPsDataFieldIndex& FieldIndex : FieldIndices)
+	{
+		if (FieldIndex.GetField()->Hash == FieldHash)
+		{
+			if (bDirty)
+			{
+				Rebuild();
+			}
+			return &FieldIndex;
+		}
+	}
+
+	UE_LOG(LogData, Error, TEXT("Property %d is not indexed in collection \"%s\""), FieldHash, *CollectionField->Name);
+	return nullptr;
+}
+
+void FPsDataCollectionIndex::Rebuild()
+{
+	bDirty = false;
+
+	TArray<UPsData*> Elements;
+	if (CollectionField->Context->IsArray())
+	{
+		TArray<UPsData*>* ArrayPtr = nullptr;
+		if (FDataReflectionTools::GetByField(Owner, CollectionField, ArrayPtr))
+		{
+			Elements = *ArrayPtr;
+		}
+	}
+	else
+	{
+		TMap<FString, UPsData*>* MapPtr = nullptr;
+		if (FDataReflectionTools::GetByField(Owner, CollectionField, MapPtr))
+		{
+			MapPtr->GenerateValueArray(Elements);
+		}
+	}
+
+	for (FPsDataFieldIndex& FieldIndex : FieldIndices)
+	{
+		FieldIndex.Build(Elements);
+	}
+}
@@ -0,0 +1,249 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "Collection/PsDataQuery.h"
+
+#include "PsData.h"
+
+#include "Async/ParallelFor.h"
+
+namespace PsDataQuery
+{
+/** Elements number to evaluate conditions in parallel */
+static constexpr int32 ParallelThreshold = 4096;
+
+/** Elements number per parallel task */
+static constexpr int32 ChunkSize = 1024;
+} // namespace PsDataQuery
+
+/***********************************
+ * FPsDataQuery
+ ***********************************/
+
+FPsDataQuery::FPsDataQuery()
+	: Class(nullptr)
+	, ProjectionReader(nullptr)
+	, LimitCount(INDEX_NONE)
+	, bValid(false)
+{
+}
+
+FPsDataQuery::FPsDataQuery(UClass* InClass)
+	: Class(InClass)
+	, ProjectionReader(nullptr)
+	, LimitCount(INDEX_NONE)
+	, bValid(InClass != nullptr)
+{
+}
+
+UClass* FPsDataQuery::GetClass() const
+{
+	return Class;
+}
+
+bool FPsDataQuery::IsValid() const
+{
+	return bValid;
+}
+
+const TSharedPtr<const FDataField>& FPsDataQuery::FindField(const FString& FieldName, FPsDataIndexKey::FReader& OutReader)
+{
+	const TSharedPtr<const FDataField>& Field = FDataReflection::GetFieldByName(Class, FieldName);
+	OutReader = Field.IsValid() ? FPsDataIndexKey::GetReader(Field) : nullptr;
+	if (OutReader == nullptr)
+	{
+		UE_LOG(LogData, Error, TEXT("Can't use property \"%s\" of \"%s\" in query"), *FieldName, *GetNameSafe(Class));
+		bValid = false;
+	}
+	return Field;
+}
+
+FPsDataQuery& FPsDataQuery::Where(const FString& FieldName, EPsDataQueryOperator Operator, const FPsDataIndexKey& Value)
+{
+	FCondition Condition;
+	Condition.Field = FindField(FieldName, Condition.Reader);
+	Condition.Operator = Operator;
+	Condition.Value = Value;
+	if (Condition.Reader)
+	{
+		Conditions.Add(MoveTemp(Condition));
+	}
+	return *this;
+}
+
+FPsDataQuery& FPsDataQuery::OrderBy(const FString& FieldName, bool bDescending)
+{
+	FOrder Order;
+	Order.Field = FindField(FieldName, Order.Reader);
+	Order.bDescending = bDescending;
+	if (Order.Reader)
+	{
+		Orders.Add(MoveTemp(Order));
+	}
+	return *this;
+}
+
+FPsDataQuery& FPsDataQuery::Limit(int32 Count)
+{
+	LimitCount = Count;
+	return *this;
+}
+
+FPsDataQuery& FPsDataQuery::Select(const FString& FieldName)
+{
+	Projection = FindField(FieldName, ProjectionReader);
+	return *this;
+}
+
+TArray<FPsDataIndexKey> FPsDataQuery::Project(const TArray<UPsData*>& Data) const
+{
+	TArray<FPsDataIndexKey> Result;
+	if (ProjectionReader == nullptr)
+	{
+		UE_LOG(LogData, Error, TEXT("Query projection is not selected"));
+		return Result;
+	}
+
+	Result.Reserve(Data.Num());
+	for (UPsData* Element : Data)
+	{
+		Result.Add(ProjectionReader(Element, Projection));
+	}
+	return Result;
+}
+
+bool FPsDataQuery::Test(UPsData* Element) const
+{
+	if (Element == nullptr || !Element->IsA(Class))
+	{
+		return false;
+	}
+
+	for (const FCondition& Condition : Conditions)
+	{
+		const FPsDataIndexKey Key = Condition.Reader(Element, Condition.Field);
+		bool bPassed = false;
+		switch (Condition.Operator)
+		{
+		case EPsDataQueryOperator::Equal:
+			bPassed = Key == Condition.Value;
+			break;
+		case EPsDataQueryOperator::NotEqual:
+			bPassed = !(Key == Condition.Value);
+			break;
+		case EPsDataQueryOperator::Less:
+			bPassed = Key < Condition.Value;
+			break;
+		case EPsDataQueryOperator::LessOrEqual:
+			bPassed = !(Condition.Value < Key);
+			break;
+		case EPsDataQueryOperator::Greater:
+			bPassed = Condition.Value < Key;
+			break;
+		case EPsDataQueryOperator::GreaterOrEqual:
+			bPassed = !(Key < Condition.Value);
+			break;
+		}
+
+		if (!bPassed)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FPsDataQuery::Evaluate(UPsData* const* Elements, int32 Num, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (!bValid)
+	{
+		UE_LOG(LogData, Error, TEXT("Can't execute invalid query"));
+		return;
+	}
+
+	if (Num >= PsDataQuery::ParallelThreshold)
+	{
+		TArray<bool> Matches;
+		Matches.SetNumUninitialized(Num);
+
+		const int32 NumChunks = FMath::DivideAndRoundUp(Num, PsDataQuery::ChunkSize);
+		ParallelFor(NumChunks, [this, Elements, Num, &Matches](int32 Chunk) {
+			const int32 First = Chunk * PsDataQuery::ChunkSize;
+			const int32 Last = FMath::Min(First + PsDataQuery::ChunkSize, Num);
+			for (int32 i = First; i < Last; ++i)
+			{
+				Matches[i] = Test(Elements[i]);
+			}
+		});
+
+		for (int32 i = 0; i < Num; ++i)
+		{
+			if (Matches[i])
+			{
+				OutIndices.Add(i);
+			}
+		}
+	}
+	else
+	{
+		for (int32 i = 0; i < Num; ++i)
+		{
+			if (Test(Elements[i]))
+			{
+				OutIndices.Add(i);
+			}
+		}
+	}
+
+	if (Orders.Num() > 0 && OutIndices.Num() > 1)
+	{
+		const int32 NumOrders = Orders.Num();
+		TArray<FPsDataIndexKey> Keys;
+		Keys.Reserve(OutIndices.Num() * NumOrders);
+		for (const int32 Index : OutIndices)
+		{
+			for (const FOrder& Order : Orders)
+			{
+				Keys.Add(Order.Reader(Elements[Index], Order.Field));
+			}
+		}
+
+		TArray<int32> Positions;
+		Positions.SetNumUninitialized(OutIndices.Num());
+		for (int32 i = 0; i < Positions.Num(); ++i)
+		{
+			Positions[i] = i;
+		}
+
+		Positions.StableSort([this, NumOrders, &Keys](const int32 A, const int32 B) {
+			for (int32 o = 0; o < NumOrders; ++o)
+			{
+				const FPsDataIndexKey& KeyA = Keys[A * NumOrders + o];
+				const FPsDataIndexKey& KeyB = Keys[B * NumOrders + o];
+				if (KeyA < KeyB)
+				{
+					return !Orders[o].bDescending;
+				}
+				if (KeyB < KeyA)
+				{
+					return Orders[o].bDescending;
+				}
+			}
+			return false;
+		});
+
+		TArray<int32> Sorted;
+		Sorted.Reserve(Positions.Num());
+		for (const int32 Position : Positions)
+		{
+			Sorted.Add(OutIndices[Position]);
+		}
+		OutIndices = MoveTemp(Sorted);
+	}
+
+	if (LimitCount >= 0 && OutIndices.Num() > LimitCount)
+	{
+		OutIndices.SetNum(LimitCount);
+	}
+}
@@ -2,17 +2,19 @@
 
 #include "PsData.h"
 
+#include "Collection/PsDataCollectionIndex.h"
+#include "PsDataChangeDispatcher.h"
 #include "PsDataCore.h"
+#include "PsDataEventQueue.h"
+#include "PsDataProfiler.h"
 #include "PsDataProperty.h"
 #include "PsDataRoot.h"
+#include "PsDataStats.h"
+#include "PsDataTransaction.h"
 #include "Serialize/PsDataBinarySerialization.h"
-#include "Serialize/Stream/PsDataBufferInputStream.h"
-#include "Serialize/Stream/PsDataBufferOutputStream.h"
 #include "Serialize/Stream/PsDataMD5OutputStream.h"
 #include "Types/PsData_UPsData.h"
 
-#include "Async/Async.h"
-
 FSimpleMulticastDelegate FDataDelegates::OnPostDataModuleInit;
 
 /***********************************
@@ -21,15 +23,30 @@ FSimpleMulticastDelegate FDataDelegates::OnPostDataModuleInit;
 
 namespace FDataReflectionTools
 {
+TMap<FName, int32> FPsDataFriend::NumTypeListeners;
+
 void FPsDataFriend::ChangeDataName(UPsData* Data, const FString& Name, const FString& CollectionName)
 {
 	if (Data->DataKey != Name || Data->CollectionKey != CollectionName)
 	{
+		const bool bMoved = Data->Parent.IsValid() && Data->CollectionKey != CollectionName;
+		if (bMoved)
+		{
+			IndexChild(Data->Parent.Get(), Data, false);
+		}
+
 		Data->DataKey = Name;
 		Data->CollectionKey = CollectionName;
-		if (Data->IsBound(UPsDataEvent::NameChanged, false))
+
+		if (bMoved)
+		{
+			UpdateCollectionField(Data);
+			IndexChild(Data->Parent.Get(), Data, true);
+		}
+
+		if (Data->IsBoundInternal(UPsDataEvent::NameChangedId, false))
 		{
-			Data->Broadcast(UPsDataEvent::ConstructEvent(UPsDataEvent::NameChanged, false));
+			Broadcast(Data, UPsDataEvent::Acquire(UPsDataEvent::NameChangedId, false));
 		}
 	}
 }
@@ -44,10 +61,26 @@ void FPsDataFriend::AddChild(UPsData* Parent, UPsData* Data)
 
 	Data->Parent = Parent;
 	Parent->Children.Add(Data);
+	++UPsData::AttachGeneration;
+	UpdateCollectionField(Data);
+	IndexChild(Parent, Data, true);
+	if (Data->NumListeners > 0)
+	{
+		Parent->AddNumListeners(Data->NumListeners);
+	}
 
-	if (Data->IsBound(UPsDataEvent::Added, true))
+	if (UPsDataRoot::NumLinkIndices > 0)
 	{
-		Data->Broadcast(UPsDataEvent::ConstructEvent(UPsDataEvent::Added, true));
+		UPsDataRoot* Root = Data->GetRoot();
+		if (Root && Root->bLinkIndex)
+		{
+			Root->IndexLinks(Data, true);
+		}
+	}
+
+	if (Data->IsBoundInternal(UPsDataEvent::AddedId, true))
+	{
+		Broadcast(Data, UPsDataEvent::Acquire(UPsDataEvent::AddedId, true));
 	}
 }
 
@@ -59,39 +92,294 @@ void FPsDataFriend::RemoveChild(UPsData* Parent, UPsData* Data)
 		return;
 	}
 
-	if (Data->IsBound(UPsDataEvent::Removing, true))
+	if (Data->IsBoundInternal(UPsDataEvent::RemovingId, true))
+	{
+		Broadcast(Data, UPsDataEvent::Acquire(UPsDataEvent::RemovingId, true));
+	}
+
+	if (UPsDataRoot::NumLinkIndices > 0)
 	{
-		Data->Broadcast(UPsDataEvent::ConstructEvent(UPsDataEvent::Removing, true));
+		UPsDataRoot* Root = Data->GetRoot();
+		if (Root && Root->bLinkIndex)
+		{
+			Root->UnindexLinks(Data, true);
+		}
 	}
 
+	IndexChild(Parent, Data, false);
+	if (Data->NumListeners > 0)
+	{
+		Parent->AddNumListeners(-Data->NumListeners);
+	}
 	Parent->Children.Remove(Data);
 	Data->Parent.Reset();
+	Data->CollectionField = nullptr;
+	++UPsData::AttachGeneration;
+}
+
+void FPsDataFriend::IndexChild(UPsData* Parent, UPsData* Data, bool bAdd)
+{
+	if (Parent->CollectionIndices.Num() > 0)
+	{
+		if (TSharedPtr<FPsDataCollectionIndex>* Find = Parent->CollectionIndices.Find(Data->CollectionKey))
+		{
+			if (bAdd)
+			{
+				(*Find)->Add(Data);
+			}
+			else
+			{
+				(*Find)->Remove(Data);
+			}
+		}
+	}
+}
+
+void FPsDataFriend::UpdateCollectionField(UPsData* Data)
+{
+	UPsData* Parent = Data->Parent.Get();
+	Data->CollectionField = Parent ? FDataReflection::GetFieldByName(Parent, Data->CollectionKey).Get() : nullptr;
 }
 
 void FPsDataFriend::Changed(UPsData* Data, const TSharedPtr<const FDataField>& Field)
 {
-	Data->DropHash();
+	++Data->Revision;
+	Data->Properties[Field->Index]->IncrementRevision();
+	FPsDataProfiler::Count(Data, EPsDataProfilerCounter::Set);
 
-	if (Field->Meta.bEvent && Data->IsBound(Field->GetChangedEventName(), Field->Meta.bBubbles))
+	if (Field->Meta.bIndex && Data->Parent.IsValid() && Data->Parent->CollectionIndices.Num() > 0)
 	{
-		Data->Broadcast(UPsDataEvent::ConstructEvent(Field->GetChangedEventName(), Field->Meta.bBubbles));
+		if (TSharedPtr<FPsDataCollectionIndex>* Find = Data->Parent->CollectionIndices.Find(Data->CollectionKey))
+		{
+			(*Find)->Update(Data, Field);
+		}
 	}
 
-	if (!Data->bChanged)
+	if (UPsDataRoot::NumLinkIndices > 0)
 	{
-		Data->bChanged = true;
-		TWeakObjectPtr<UPsData> DataWeakPtr(Data);
-		AsyncTask(ENamedThreads::GameThread, [DataWeakPtr]() {
-			if (DataWeakPtr.IsValid())
+		for (const auto& Pair : FDataReflection::GetLinks(Data->GetClass()))
+		{
+			const TSharedPtr<const FDataLink>& Link = Pair.Value;
+			if (Link->Name == Field->Name || (Link->bPathProperty && Link->Path == Field->Name))
 			{
-				DataWeakPtr->bChanged = false;
-				if (DataWeakPtr->IsBound(UPsDataEvent::Changed, false))
+				UPsDataRoot* Root = Data->GetRoot();
+				if (Root && Root->bLinkIndex)
 				{
-					DataWeakPtr->Broadcast(UPsDataEvent::ConstructEvent(UPsDataEvent::Changed, false));
+					Root->IndexLinks(Data, false);
 				}
+				break;
 			}
-		});
+		}
 	}
+
+	if (FPsDataTransaction* Transaction = FPsDataTransaction::GetCurrent())
+	{
+		Transaction->Changed(Data, Field);
+		return;
+	}
+
+	Data->DropHash();
+	BroadcastChanged(Data, Field);
+}
+
+void FPsDataFriend::ChangedElement(UPsData* Data, const TSharedPtr<const FDataField>& Field, FName Type, int32 Index)
+{
+	if (FPsDataTransaction* Transaction = FPsDataTransaction::GetCurrent())
+	{
+		Transaction->ChangedElement(Data, Field, Type, Index);
+	}
+	else
+	{
+		BroadcastElement(Data, Field, Type, Index);
+	}
+
+	Changed(Data, Field);
+}
+
+void FPsDataFriend::Changing(UPsData* Data, FAbstractDataProperty* Property)
+{
+	if (FPsDataTransaction* Transaction = FPsDataTransaction::GetCurrent())
+	{
+		Transaction->Record(Data, Property);
+	}
+}
+
+void FPsDataFriend::BroadcastChanged(UPsData* Data, const TSharedPtr<const FDataField>& Field, TSet<TPair<const UPsData*, const FDataField*>>* Bubbled)
+{
+	if (Field->Meta.bEvent && Data->IsBoundInternal(Field->GetChangedEventId(), Field->Meta.bBubbles))
+	{
+		UPsDataEvent* Event = UPsDataEvent::Acquire(Field->GetChangedEventId(), Field->Meta.bBubbles);
+		Event->Field = Field;
+		Event->Bubbled = Bubbled;
+		Broadcast(Data, Event);
+	}
+
+	if (!Data->bChanged)
+	{
+		Data->bChanged = true;
+		FPsDataChangeDispatcher::Get().Add(Data);
+	}
+}
+
+void FPsDataFriend::Broadcast(UPsData* Data, UPsDataEvent* Event)
+{
+	FPsDataEventQueue::Get().Broadcast(Data, Event, true);
+}
+
+void FPsDataFriend::DispatchEvent(const UPsData* Data, UPsDataEvent* Event)
+{
+	PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataBroadcast);
+	PSDATA_TRACE_BROADCAST(Data, Event->TypeId);
+	FPsDataProfiler::Count(Data, EPsDataProfilerCounter::Broadcast);
+
+	Data->BroadcastInternal(Event, nullptr);
+}
+
+void FPsDataFriend::BroadcastElement(UPsData* Data, const TSharedPtr<const FDataField>& Field, FName Type, int32 Index)
+{
+	if (Data->IsBoundInternal(Type, Field->Meta.bBubbles))
+	{
+		UPsDataEvent* Event = UPsDataEvent::Acquire(Type, Field->Meta.bBubbles);
+		Event->Field = Field;
+		Event->Index = Index;
+		Broadcast(Data, Event);
+	}
+}
+
+void FPsDataFriend::DispatchChanged(UPsData* Data)
+{
+	Data->bChanged = false;
+	if (Data->IsBoundInternal(UPsDataEvent::ChangedId, false))
+	{
+		Broadcast(Data, UPsDataEvent::Acquire(UPsDataEvent::ChangedId, false));
+	}
+}
+
+void FPsDataFriend::ResetChanged(UPsData* Data)
+{
+	Data->bChanged = false;
+}
+
+void FPsDataFriend::AddListener(FName Type)
+{
+	++NumTypeListeners.FindOrAdd(Type);
+}
+
+void FPsDataFriend::RemoveListener(FName Type)
+{
+	int32* Find = NumTypeListeners.Find(Type);
+	if (Find && --(*Find) <= 0)
+	{
+		NumTypeListeners.Remove(Type);
+	}
+}
+
+bool FPsDataFriend::HasListeners(FName Type)
+{
+	return NumTypeListeners.Contains(Type);
+}
+
+UPsData* FPsDataFriend::Clone(const UPsData* Source, UObject* Outer)
+{
+	UPsData* Data = NewObject<UPsData>(Outer, Source->GetClass());
+	check(Data->Properties.Num() == Source->Properties.Num());
+
+	for (int32 i = 0; i < Source->Properties.Num(); ++i)
+	{
+		Data->Properties[i]->CopyFrom(Data, Source->Properties[i]);
+	}
+
+	// Properties changed by PostDeserialize drop copied hash
+	Data->Hash = Source->Hash;
+	Data->PostDeserialize();
+
+	return Data;
+}
+
+void FPsDataFriend::AttachClone(UPsData* Parent, UPsData* Data, const FString& Name, const FString& CollectionName)
+{
+	check(!Data->Parent.IsValid());
+
+	Data->DataKey = Name;
+	Data->CollectionKey = CollectionName;
+	Data->Parent = Parent;
+	Parent->Children.Add(Data);
+	++UPsData::AttachGeneration;
+	UpdateCollectionField(Data);
+	IndexChild(Parent, Data, true);
+	if (Data->NumListeners > 0)
+	{
+		Parent->AddNumListeners(Data->NumListeners);
+	}
+}
+
+void FPsDataFriend::DetachClone(UPsData* Parent, UPsData* Data)
+{
+	check(Data->Parent == Parent);
+
+	IndexChild(Parent, Data, false);
+	if (Data->NumListeners > 0)
+	{
+		Parent->AddNumListeners(-Data->NumListeners);
+	}
+	Parent->Children.Remove(Data);
+	Data->Parent.Reset();
+	Data->CollectionField = nullptr;
+	++UPsData::AttachGeneration;
+}
+
+void FPsDataFriend::CountMemory(const UPsData* Data, FPsDataMemoryUsage& Usage)
+{
+	Usage.Object += Data->GetClass()->GetStructureSize();
+
+	Usage.Properties += Data->Properties.GetAllocatedSize();
+	for (const FAbstractDataProperty* Property : Data->Properties)
+	{
+		Usage.Properties += Property->GetAllocatedSize();
+	}
+
+	Usage.Delegates += Data->Delegates.GetAllocatedSize();
+	for (const auto& Pair : Data->Delegates)
+	{
+		Usage.Delegates += sizeof(UPsData::FDelegateList) + Pair.Value->GetAllocatedSize() + Pair.Value->Num() * sizeof(FDelegateWrapper);
+	}
+
+	Usage.Children += Data->Children.GetAllocatedSize();
+	Usage.Keys += Data->DataKey.GetAllocatedSize() + Data->CollectionKey.GetAllocatedSize();
+	Usage.Hash += Data->Hash.IsSet() ? sizeof(FPsDataMD5Hash) : 0;
+}
+
+void FPsDataFriend::DropHash(UPsData* Data, TSet<UPsData*>& Dropped)
+{
+	for (UPsData* It = Data; It != nullptr; It = It->Parent.Get())
+	{
+		bool bAlreadyDropped = false;
+		Dropped.Add(It, &bAlreadyDropped);
+		if (bAlreadyDropped)
+		{
+			break;
+		}
+
+		It->Hash.Reset();
+	}
+}
+
+const FString& FPsDataFriend::GetIndexName(int32 Index)
+{
+	check(Index >= 0);
+
+	// Names are allocated separately, so returned references survive array growth
+	static TArray<TUniquePtr<FString>> IndexNames;
+	if (Index >= IndexNames.Num())
+	{
+		IndexNames.Reserve(FMath::RoundUpToPowerOfTwo(Index + 1));
+		for (int32 i = IndexNames.Num(); i <= Index; ++i)
+		{
+			IndexNames.Add(MakeUnique<FString>(FString::FromInt(i)));
+		}
+	}
+
+	return *IndexNames[Index];
 }
 
 void FPsDataFriend::InitProperties(UPsData* Data)
@@ -105,6 +393,11 @@ TArray<FAbstractDataProperty*>& FPsDataFriend::GetProperties(UPsData* Data)
 	return Data->Properties;
 }
 
+const TSet<UPsData*>& FPsDataFriend::GetChildren(const UPsData* Data)
+{
+	return Data->Children;
+}
+
 void FPsDataFriend::Serialize(const UPsData* Data, FPsDataSerializer* Serializer)
 {
 	Data->DataSerializeInternal(Serializer);
@@ -114,6 +407,79 @@ void FPsDataFriend::Deserialize(UPsData* Data, FPsDataDeserializer* Deserializer
 {
 	Data->DataDeserializeInternal(Deserializer);
 }
+
+void FPsDataFriend::PostDeserialize(UPsData* Data)
+{
+	if (Data->bChanged)
+	{
+		Data->PostDeserialize();
+	}
+}
+
+const FDataClassLayout* FPsDataFriend::GetLayout(const UPsData* Data)
+{
+	if (Data->Layout == nullptr)
+	{
+		Data->Layout = FDataReflection::GetClassLayout(Data->GetClass());
+	}
+	return Data->Layout;
+}
+
+const TArray<UPsData*>* FPsDataFriend::FindLinkCache(const UPsData* Data, int32 LinkHash)
+{
+	UPsData::FLinkCache* Find = Data->LinkCache.Find(LinkHash);
+	if (Find == nullptr || Find->Revision != Data->Revision)
+	{
+		return nullptr;
+	}
+
+	const UPsData* CollectionOwner = Find->CollectionOwner.Get();
+	if (CollectionOwner == nullptr || !Find->Root.IsValid() || CollectionOwner->Properties[Find->CollectionIndex]->GetRevision() != Find->CollectionRevision)
+	{
+		return nullptr;
+	}
+
+	// Data or collection owner moved to other root or detached means the path to collection changed
+	if (Find->AttachGeneration != UPsData::AttachGeneration)
+	{
+		const UPsDataRoot* Root = Data->GetRoot();
+		if (Root == nullptr || Root != Find->Root.Get() || CollectionOwner->GetRoot() != Root)
+		{
+			return nullptr;
+		}
+		Find->AttachGeneration = UPsData::AttachGeneration;
+	}
+
+	return &Find->Targets;
+}
+
+FPsDataCollectionIndex& FPsDataFriend::GetCollectionIndex(UPsData* Data, const TSharedPtr<const FDataField>& Field)
+{
+	TSharedPtr<FPsDataCollectionIndex>& Index = Data->CollectionIndices.FindOrAdd(Field->Name);
+	if (!Index.IsValid())
+	{
+		Index = MakeShared<FPsDataCollectionIndex>(Data, Field);
+	}
+	return *Index;
+}
+
+void FPsDataFriend::SetLinkCache(const UPsData* Data, int32 LinkHash, const TArray<UPsData*>& Targets, UPsData* CollectionOwner, const TSharedPtr<const FDataField>& CollectionField)
+{
+	UPsDataRoot* Root = Data->GetRoot();
+	if (Root == nullptr || CollectionOwner == nullptr || !CollectionField.IsValid())
+	{
+		return;
+	}
+
+	UPsData::FLinkCache& Cache = Data->LinkCache.FindOrAdd(LinkHash);
+	Cache.Revision = Data->Revision;
+	Cache.Root = Root;
+	Cache.AttachGeneration = UPsData::AttachGeneration;
+	Cache.CollectionOwner = CollectionOwner;
+	Cache.CollectionIndex = CollectionField->Index;
+	Cache.CollectionRevision = CollectionOwner->Properties[CollectionField->Index]->GetRevision();
+	Cache.Targets = Targets;
+}
 } // namespace FDataReflectionTools
 
 /***********************************
@@ -190,11 +556,17 @@ FPsDataReport::FPsDataReport(EPsDataReportType InType, const FString& InSourcePa
 * PSDATA!
 ***********************************/
 
+uint32 UPsData::AttachGeneration = 0;
+
 UPsData::UPsData(const class FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, Layout(nullptr)
+	, Revision(0)
 	, DataKey()
+	, CollectionField(nullptr)
 	, Parent(nullptr)
-	, BroadcastInProgress(0)
+	, bDelegatesDirty(false)
+	, NumListeners(0)
 	, bChanged(false)
 {
 	FDataReflection::PreConstruct(this);
@@ -219,6 +591,9 @@ void UPsData::DropHash()
 
 void UPsData::CalculateHash() const
 {
+	PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataCalculateHash);
+	FPsDataProfiler::Count(this, EPsDataProfilerCounter::CalculateHash);
+
 	struct HashBinarySerializer : public FPsDataBinarySerializer
 	{
 		HashBinarySerializer(TSharedRef<FPsDataOutputStream> InOutputStream)
@@ -267,135 +642,183 @@ void UPsData::PostDeserialize()
  ***********************************/
 
 bool UPsData::IsBound(const FString& Type, bool bBubbles) const
+{
+	const FName TypeId(*Type, FNAME_Find);
+	return !TypeId.IsNone() && IsBoundInternal(TypeId, bBubbles);
+}
+
+bool UPsData::IsBoundInternal(FName Type, bool bBubbles) const
+{
+	if (!FDataReflectionTools::FPsDataFriend::HasListeners(Type))
+	{
+		return false;
+	}
+
+	const UPsData* Data = this;
+	const UPsData* Previous = nullptr;
+	while (Data)
+	{
+		// Listeners of data itself and of its other children
+		const int32 NumOther = Data->NumListeners - (Previous ? Previous->NumListeners : 0);
+		if (NumOther > 0 && Data->IsBoundOwn(Type))
+		{
+			return true;
+		}
+
+		if (!bBubbles)
+		{
+			break;
+		}
+
+		Previous = Data;
+		Data = Data->Parent.Get();
+	}
+
+	return false;
+}
+
+bool UPsData::IsBoundOwn(FName Type) const
 {
 	auto Find = Delegates.Find(Type);
 	if (Find)
 	{
-		for (auto& Wrapper : *Find)
+		for (auto& Wrapper : **Find)
 		{
 			if (Wrapper->IsBound())
 			{
 				return true;
 			}
+			bDelegatesDirty = true;
 		}
 	}
 
-	if (bBubbles && Parent.IsValid())
-	{
-		return Parent->IsBound(Type, bBubbles);
-	}
-
 	return false;
 }
 
-void UPsData::Broadcast(UPsDataEvent* Event) const
+void UPsData::AddNumListeners(int32 Delta) const
 {
-	const bool bDeferredEventProcessing = false;
-	if (bDeferredEventProcessing)
+	for (const UPsData* Data = this; Data; Data = Data->Parent.Get())
 	{
-		TWeakObjectPtr<UPsData> WeakPtr(const_cast<UPsData*>(this));
-		Event->AddToRoot();
-		AsyncTask(ENamedThreads::GameThread, [WeakPtr, Event]() {
-			Event->RemoveFromRoot();
-			if (WeakPtr.IsValid())
-			{
-				WeakPtr->BroadcastInternal(Event, nullptr);
-			}
-		});
-	}
-	else
-	{
-		BroadcastInternal(Event, nullptr);
+		Data->NumListeners += Delta;
 	}
 }
 
-FPsDataBind UPsData::Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const
+void UPsData::Broadcast(UPsDataEvent* Event) const
 {
-	return BindInternal(Type, Delegate);
+	FPsDataEventQueue::Get().Broadcast(this, Event, false);
 }
 
-FPsDataBind UPsData::Bind(const FString& Type, const FPsDataDelegate& Delegate) const
+FPsDataBind UPsData::Bind(const FString& Type, const FPsDataDynamicDelegate& Delegate, int32 Priority) const
 {
-	return BindInternal(Type, Delegate);
+	return BindInternal(FName(*Type), Delegate, nullptr, Priority);
+}
+
+FPsDataBind UPsData::Bind(const FString& Type, const FPsDataDelegate& Delegate, int32 Priority) const
+{
+	return BindInternal(FName(*Type), Delegate, nullptr, Priority);
 }
 
 void UPsData::Unbind(const FString& Type, const FPsDataDynamicDelegate& Delegate) const
 {
-	UnbindInternal(Type, Delegate);
+	UnbindInternal(FName(*Type, FNAME_Find), Delegate);
 }
 
 void UPsData::Unbind(const FString& Type, const FPsDataDelegate& Delegate) const
 {
-	UnbindInternal(Type, Delegate);
+	UnbindInternal(FName(*Type, FNAME_Find), Delegate);
 }
 
-FPsDataBind UPsData::Bind(int32 FieldHash, const FPsDataDynamicDelegate& Delegate) const
+FPsDataBind UPsData::Bind(int32 FieldHash, const FPsDataDynamicDelegate& Delegate, int32 Priority) const
 {
-	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(GetClass(), FieldHash);
+	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(this, FieldHash);
 	check(Field.IsValid());
-	return BindInternal(Field->GetChangedEventName(), Delegate);
+	return BindInternal(Field->GetChangedEventId(), Delegate, nullptr, Priority);
 }
 
-FPsDataBind UPsData::Bind(int32 FieldHash, const FPsDataDelegate& Delegate) const
+FPsDataBind UPsData::Bind(int32 FieldHash, const FPsDataDelegate& Delegate, int32 Priority) const
 {
-	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(GetClass(), FieldHash);
+	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(this, FieldHash);
 	check(Field.IsValid());
-	return BindInternal(Field->GetChangedEventName(), Delegate);
+	return BindInternal(Field->GetChangedEventId(), Delegate, nullptr, Priority);
 }
 
 void UPsData::Unbind(int32 FieldHash, const FPsDataDynamicDelegate& Delegate) const
 {
-	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(GetClass(), FieldHash);
+	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(this, FieldHash);
 	check(Field.IsValid());
-	UnbindInternal(Field->GetChangedEventName(), Delegate);
+	UnbindInternal(Field->GetChangedEventId(), Delegate);
 }
 
 void UPsData::Unbind(int32 FieldHash, const FPsDataDelegate& Delegate) const
 {
-	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(GetClass(), FieldHash);
+	TSharedPtr<const FDataField> Field = FDataReflection::GetFieldByHash(this, FieldHash);
 	check(Field.IsValid());
-	UnbindInternal(Field->GetChangedEventName(), Delegate);
+	UnbindInternal(Field->GetChangedEventId(), Delegate);
 }
 
 void UPsData::BlueprintBind(const FString& Type, const FPsDataDynamicDelegate& Delegate)
 {
-	BindInternal(Type, Delegate);
+	BindInternal(FName(*Type), Delegate);
 }
 
 void UPsData::BlueprintUnbind(const FString& Type, const FPsDataDynamicDelegate& Delegate)
 {
-	UnbindInternal(Type, Delegate);
+	UnbindInternal(FName(*Type, FNAME_Find), Delegate);
 }
 
 void UPsData::UpdateDelegates() const
 {
-	if (BroadcastInProgress > 0)
+	if (!bDelegatesDirty)
 	{
 		return;
 	}
 
+	bDelegatesDirty = false;
+
+	// Lists are shared with broadcasts in progress, so changed list is replaced instead of modified
+	int32 NumRemoved = 0;
 	for (auto MapIt = Delegates.CreateIterator(); MapIt; ++MapIt)
 	{
-		for (auto ArrayIt = MapIt->Value.CreateIterator(); ArrayIt; ++ArrayIt)
+		const FDelegateList& List = *MapIt->Value;
+
+		int32 NumBound = 0;
+		for (auto& Wrapper : List)
 		{
-			TSharedRef<FDelegateWrapper>& Wrapper = *ArrayIt;
-			if (!Wrapper->DynamicDelegate.IsBound() && !Wrapper->Delegate.IsBound())
+			if (Wrapper->IsBound())
 			{
-				ArrayIt.RemoveCurrent();
+				++NumBound;
 			}
 		}
 
-		if (MapIt->Value.Num() == 0)
+		NumRemoved += List.Num() - NumBound;
+
+		if (NumBound == 0)
 		{
 			MapIt.RemoveCurrent();
 		}
+		else if (NumBound < List.Num())
+		{
+			TSharedRef<FDelegateList> Compacted = MakeShared<FDelegateList>();
+			Compacted->Reserve(NumBound);
+			for (auto& Wrapper : List)
+			{
+				if (Wrapper->IsBound())
+				{
+					Compacted->Add(Wrapper);
+				}
+			}
+			MapIt->Value = Compacted;
+		}
+	}
+
+	if (NumRemoved > 0)
+	{
+		AddNumListeners(-NumRemoved);
 	}
 }
 
 void UPsData::BroadcastInternal(UPsDataEvent* Event, const UPsData* Previous) const
 {
-	++BroadcastInProgress;
-
 	if (Event->Target == nullptr)
 	{
 		Event->Target = const_cast<UPsData*>(this);
@@ -403,26 +826,33 @@ void UPsData::BroadcastInternal(UPsDataEvent* Event, const UPsData* Previous) co
 
 	if (!Event->bStopImmediate)
 	{
-		auto Find = Delegates.Find(Event->Type);
+		auto Find = Delegates.Find(Event->TypeId);
 		if (Find)
 		{
-			TArray<TSharedRef<FDelegateWrapper>> Copy = *Find;
-			for (auto& Wrapper : Copy)
+			// Hold the list: binds and compaction during broadcast replace it and don't affect this iteration
+			const TSharedRef<const FDelegateList> List = *Find;
+			for (auto& Wrapper : *List)
 			{
+				if (!Wrapper->IsBound())
+				{
+					bDelegatesDirty = true;
+					continue;
+				}
+
 				bool bExecute = true;
 				if (Wrapper->Field.IsValid())
 				{
 					bExecute = false;
 					if (Previous == nullptr)
 					{
-						if (Event->Type == Wrapper->Field->GetChangedEventName())
+						if (Event->Field == Wrapper->Field || Event->TypeId == Wrapper->Field->GetChangedEventId())
 						{
 							bExecute = true;
 						}
 					}
 					else if (Wrapper->Field->Context->IsContainer())
 					{
-						if (Wrapper->Field->Name == Previous->GetCollectionKey())
+						if (Wrapper->Field.Get() == Previous->CollectionField)
 						{
 							bExecute = true;
 						}
@@ -430,7 +860,11 @@ void UPsData::BroadcastInternal(UPsDataEvent* Event, const UPsData* Previous) co
 				}
 				if (bExecute)
 				{
-					Wrapper->DynamicDelegate.ExecuteIfBound(Event);
+					if (Wrapper->DynamicDelegate.IsBound())
+					{
+						Event->bRetained = true;
+						Wrapper->DynamicDelegate.Execute(Event);
+					}
 					Wrapper->Delegate.ExecuteIfBound(Event);
 					if (Event->bStopImmediate)
 					{
@@ -445,55 +879,83 @@ void UPsData::BroadcastInternal(UPsDataEvent* Event, const UPsData* Previous) co
 	{
 		if (Parent.IsValid())
 		{
-			Parent->BroadcastInternal(Event, this);
+			bool bAlreadyBubbled = false;
+			if (Event->Bubbled)
+			{
+				Event->Bubbled->Add(TPair<const UPsData*, const FDataField*>(Parent.Get(), CollectionField), &bAlreadyBubbled);
+			}
+
+			if (!bAlreadyBubbled)
+			{
+				Parent->BroadcastInternal(Event, this);
+			}
 		}
 	}
 
-	--BroadcastInProgress;
+	UpdateDelegates();
+}
 
+void UPsData::AddDelegate(FName Type, const TSharedRef<FDelegateWrapper>& Wrapper) const
+{
 	UpdateDelegates();
+
+	TSharedRef<FDelegateList> List = MakeShared<FDelegateList>();
+	if (auto Find = Delegates.Find(Type))
+	{
+		List->Reserve((*Find)->Num() + 1);
+		List->Append(**Find);
+	}
+
+	// Wrapper goes after all wrappers with same or higher priority
+	int32 Index = List->Num();
+	while (Index > 0 && (*List)[Index - 1]->Priority < Wrapper->Priority)
+	{
+		--Index;
+	}
+	List->Insert(Wrapper, Index);
+	Delegates.Add(Type, List);
+	AddNumListeners(1);
 }
 
-FPsDataBind UPsData::BindInternal(const FString& Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field) const
+FPsDataBind UPsData::BindInternal(FName Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field, int32 Priority) const
 {
 	if (!Delegate.IsBound())
 	{
 		return {};
 	}
 
-	TSharedRef<FDelegateWrapper> Ref(new FDelegateWrapper(Delegate, Field));
-	Delegates.FindOrAdd(Type).Add(Ref);
-	UpdateDelegates();
+	TSharedRef<FDelegateWrapper> Ref(new FDelegateWrapper(Type, Delegate, Field, Priority));
+	AddDelegate(Type, Ref);
 
 	return FPsDataBind(Ref);
 }
 
-FPsDataBind UPsData::BindInternal(const FString& Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field) const
+FPsDataBind UPsData::BindInternal(FName Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field, int32 Priority) const
 {
 	if (!Delegate.IsBound())
 	{
 		return FPsDataBind();
 	}
 
-	TSharedRef<FDelegateWrapper> Ref(new FDelegateWrapper(Delegate, Field));
-	Delegates.FindOrAdd(Type).Add(Ref);
-	UpdateDelegates();
+	TSharedRef<FDelegateWrapper> Ref(new FDelegateWrapper(Type, Delegate, Field, Priority));
+	AddDelegate(Type, Ref);
 
 	return FPsDataBind(Ref);
 }
 
-void UPsData::UnbindInternal(const FString& Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field) const
+void UPsData::UnbindInternal(FName Type, const FPsDataDynamicDelegate& Delegate, TSharedPtr<const FDataField> Field) const
 {
 	if (Delegate.IsBound())
 	{
 		auto Find = Delegates.Find(Type);
 		if (Find)
 		{
-			for (auto& Wrapper : *Find)
+			for (auto& Wrapper : **Find)
 			{
 				if (Wrapper->DynamicDelegate == Delegate && Wrapper->Field == Field)
 				{
 					Wrapper->DynamicDelegate.Unbind();
+					bDelegatesDirty = true;
 				}
 			}
 		}
@@ -502,18 +964,19 @@ void UPsData::UnbindInternal(const FString& Type, const FPsDataDynamicDelegate&
 	UpdateDelegates();
 }
 
-void UPsData::UnbindInternal(const FString& Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field) const
+void UPsData::UnbindInternal(FName Type, const FPsDataDelegate& Delegate, TSharedPtr<const FDataField> Field) const
 {
 	if (Delegate.IsBound())
 	{
 		auto Find = Delegates.Find(Type);
 		if (Find)
 		{
-			for (auto& Wrapper : *Find)
+			for (auto& Wrapper : **Find)
 			{
 				if (Wrapper->Delegate.GetHandle() == Delegate.GetHandle() && Wrapper->Field == Field)
 				{
 					Wrapper->Delegate.Unbind();
+					bDelegatesDirty = true;
 				}
 			}
 		}
@@ -528,11 +991,15 @@ void UPsData::UnbindInternal(const FString& Type, const FPsDataDelegate& Delegat
 
 void UPsData::DataSerialize(FPsDataSerializer* Serializer) const
 {
+	PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataSerialize);
+
 	Serializer->WriteValue(this);
 }
 
 void UPsData::DataDeserialize(FPsDataDeserializer* Deserializer, bool bPatch)
 {
+	PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataDeserialize);
+
 	if (!bPatch)
 	{
 		Reset();
@@ -545,6 +1012,17 @@ void UPsData::DataDeserialize(FPsDataDeserializer* Deserializer, bool bPatch)
 
 void UPsData::DataSerializeInternal(FPsDataSerializer* Serializer) const
 {
+	if (const FPsDataClassPlan* Plan = FDataReflection::GetClassPlan(GetClass()))
+	{
+		for (const FPsDataClassPlanEntry& Entry : Plan->Entries)
+		{
+			Serializer->WriteFieldKey(Entry);
+			Properties[Entry.Index]->Serialize(this, Serializer);
+			Serializer->PopKey(Entry.Alias);
+		}
+		return;
+	}
+
 	for (auto& Pair : FDataReflection::GetAliasFields(this->GetClass()))
 	{
 		Serializer->WriteKey(Pair.Key);
@@ -555,14 +1033,31 @@ void UPsData::DataSerializeInternal(FPsDataSerializer* Serializer) const
 
 void UPsData::DataDeserializeInternal(FPsDataDeserializer* Deserializer)
 {
+	const FPsDataClassPlan* Plan = FDataReflection::GetClassPlan(GetClass());
 	const auto& Fields = FDataReflection::GetAliasFields(this->GetClass());
+	int32 Hint = 0;
 	FString Key;
 	while (Deserializer->ReadKey(Key))
 	{
-		if (auto Find = Fields.Find(Key))
+		int32 PropertyIndex = INDEX_NONE;
+		if (Plan)
+		{
+			// keys are usually written in plan order, so next entry is checked first
+			const int32 EntryIndex = Plan->Find(Key, Hint);
+			if (EntryIndex != INDEX_NONE)
+			{
+				PropertyIndex = Plan->Entries[EntryIndex].Index;
+				Hint = EntryIndex + 1;
+			}
+		}
+		else if (auto Find = Fields.Find(Key))
+		{
+			PropertyIndex = (*Find)->Index;
+		}
+
+		if (PropertyIndex != INDEX_NONE)
 		{
-			auto& Field = *Find;
-			Properties[Field->Index]->Deserialize(this, Deserializer);
+			Properties[PropertyIndex]->Deserialize(this, Deserializer);
 		}
 		else
 		{
@@ -678,13 +1173,7 @@ void UPsData::Reset()
 
 UPsData* UPsData::Copy() const
 {
-	auto OutputStream = MakeShared<FPsDataBufferOutputStream>();
-	FPsDataBinarySerializer Serializer(OutputStream);
-	DataSerialize(&Serializer);
-	UPsData* Copy = NewObject<UPsData>(GetTransientPackage(), GetClass());
-	FPsDataBinaryDeserializer Deserializer(MakeShared<FPsDataBufferInputStream>(OutputStream->GetBuffer()));
-	Copy->DataDeserialize(&Deserializer);
-	return Copy;
+	return FDataReflectionTools::FPsDataFriend::Clone(this, GetTransientPackage());
 }
 
 TArray<FPsDataReport> UPsData::Validation() const
@@ -693,7 +1182,6 @@ TArray<FPsDataReport> UPsData::Validation() const
 
 	//TODO: PS-136
 	UPsData* Data = const_cast<UPsData*>(this);
-	UPsData* RootData = Data->GetRoot();
 	FString Path = GetPathFromRoot();
 
 	for (auto& Pair : FDataReflection::GetLinks(GetClass()))
@@ -708,9 +1196,9 @@ TArray<FPsDataReport> UPsData::Validation() const
 		{
 			TArray<FString> Keys;
 			UPsDataFunctionLibrary::GetLinkKeys(Data, Pair.Value, Keys);
-			TMap<FString, UPsData*>* MapPtr = nullptr;
 			const FString& LinkPath = UPsDataFunctionLibrary::GetLinkPath(Data, Pair.Value);
-			if (FDataReflectionTools::GetByPath(RootData, LinkPath, MapPtr))
+			TMap<FString, UPsData*>* MapPtr = UPsDataFunctionLibrary::GetLinkCollection(Data, Pair.Value);
+			if (MapPtr)
 			{
 				TMap<FString, UPsData*> Map = *MapPtr;
 				for (const FString& Key : Keys)
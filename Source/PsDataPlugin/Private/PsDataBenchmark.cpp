@@ -0,0 +1,480 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "PsDataBenchmark.h"
+
+#include "PsDataChangeDispatcher.h"
+#include "PsDataEventQueue.h"
+#include "Serialize/PsDataBinarySerialization.h"
+#include "Serialize/PsDataFastJsonSerialization.h"
+#include "Serialize/PsDataJsonSerialization.h"
+#include "Serialize/PsDataMsgPackSerialization.h"
+#include "Serialize/Stream/PsDataBufferInputStream.h"
+#include "Serialize/Stream/PsDataBufferOutputStream.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectArray.h"
+
+#if !UE_BUILD_SHIPPING
+
+/***********************************
+ * FPsDataBenchmark
+ ***********************************/
+
+struct FPsDataBenchmarkSettings
+{
+	/** Number of levels below root */
+	int32 Depth = 4;
+
+	/** Number of children of every node */
+	int32 Width = 4;
+
+	/** Part of children stored in map, the rest is stored in array */
+	float MapRatio = 0.5f;
+
+	/** Length of string property */
+	int32 StringLength = 16;
+
+	/** Length of int array property */
+	int32 Numbers = 8;
+
+	/** Number of listeners in broadcast benchmark */
+	int32 Listeners = 16;
+
+	/** Number of runs of every benchmark */
+	int32 Iterations = 20;
+
+	/** Random seed */
+	int32 Seed = 1;
+};
+
+struct FPsDataBenchmarkResult
+{
+	FString Name;
+
+	/** Number of measured operations */
+	int64 Operations = 0;
+
+	/** Measured time */
+	double Seconds = 0.0;
+
+	/** Bytes produced or consumed by all operations */
+	int64 Bytes = 0;
+
+	/** UObjects allocated by all operations */
+	int64 Objects = 0;
+};
+
+class FPsDataBenchmark
+{
+public:
+	FPsDataBenchmark(const FPsDataBenchmarkSettings& InSettings)
+		: Settings(InSettings)
+		, Random(InSettings.Seed)
+		, Root(nullptr)
+		, NumNodes(0)
+	{
+		// Results are referenced while next ones are added
+		Results.Reserve(32);
+	}
+
+	/** Run all benchmarks */
+	void Run()
+	{
+		Root = MakeNode(0);
+		Root->AddToRoot();
+
+		RunSerialization();
+		RunCopy();
+		RunHash();
+		RunCollections();
+		RunBroadcast();
+
+		Root->RemoveFromRoot();
+		Root = nullptr;
+	}
+
+	/** Results as JSON */
+	FString ToJson() const
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+
+		TSharedRef<FJsonObject> JsonSettings = MakeShared<FJsonObject>();
+		JsonSettings->SetNumberField(TEXT("Depth"), Settings.Depth);
+		JsonSettings->SetNumberField(TEXT("Width"), Settings.Width);
+		JsonSettings->SetNumberField(TEXT("MapRatio"), Settings.MapRatio);
+		JsonSettings->SetNumberField(TEXT("StringLength"), Settings.StringLength);
+		JsonSettings->SetNumberField(TEXT("Numbers"), Settings.Numbers);
+		JsonSettings->SetNumberField(TEXT("Listeners"), Settings.Listeners);
+		JsonSettings->SetNumberField(TEXT("Iterations"), Settings.Iterations);
+		JsonSettings->SetNumberField(TEXT("Seed"), Settings.Seed);
+		Json->SetObjectField(TEXT("Settings"), JsonSettings);
+		Json->SetNumberField(TEXT("Nodes"), NumNodes);
+
+		TArray<TSharedPtr<FJsonValue>> JsonResults;
+		for (const FPsDataBenchmarkResult& Result : Results)
+		{
+			TSharedRef<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+			JsonResult->SetStringField(TEXT("Name"), Result.Name);
+			JsonResult->SetNumberField(TEXT("Operations"), Result.Operations);
+			JsonResult->SetNumberField(TEXT("Seconds"), Result.Seconds);
+			JsonResult->SetNumberField(TEXT("OperationsPerSecond"), GetRate(Result.Operations, Result.Seconds));
+			JsonResult->SetNumberField(TEXT("BytesPerSecond"), GetRate(Result.Bytes, Result.Seconds));
+			JsonResult->SetNumberField(TEXT("ObjectsPerOperation"), Result.Operations > 0 ? static_cast<double>(Result.Objects) / Result.Operations : 0.0);
+			JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+		}
+		Json->SetArrayField(TEXT("Results"), JsonResults);
+
+		FString Output;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Json, Writer);
+		return Output;
+	}
+
+	/** Print results to log */
+	void Log() const
+	{
+		UE_LOG(LogData, Display, TEXT("PsData benchmark, %d nodes:"), NumNodes);
+		UE_LOG(LogData, Display, TEXT("%-32s %14s %14s %12s"), TEXT("Name"), TEXT("Ops/s"), TEXT("MB/s"), TEXT("Objects/op"));
+		for (const FPsDataBenchmarkResult& Result : Results)
+		{
+			UE_LOG(LogData, Display, TEXT("%-32s %14.1f %14.2f %12.2f"),
+				*Result.Name,
+				GetRate(Result.Operations, Result.Seconds),
+				GetRate(Result.Bytes, Result.Seconds) / (1024.0 * 1024.0),
+				Result.Operations > 0 ? static_cast<double>(Result.Objects) / Result.Operations : 0.0);
+		}
+	}
+
+private:
+	/** Measured scope, adds time and allocated objects to result */
+	struct FMeasure
+	{
+		FMeasure(FPsDataBenchmarkResult& InResult)
+			: Result(InResult)
+			, StartObjects(GUObjectArray.GetObjectArrayNumMinusAvailable())
+			, StartTime(FPlatformTime::Seconds())
+		{
+		}
+
+		~FMeasure()
+		{
+			Result.Seconds += FPlatformTime::Seconds() - StartTime;
+			Result.Objects += GUObjectArray.GetObjectArrayNumMinusAvailable() - StartObjects;
+		}
+
+		FPsDataBenchmarkResult& Result;
+		int32 StartObjects;
+		double StartTime;
+	};
+
+	static double GetRate(int64 Value, double Seconds)
+	{
+		return Seconds > 0.0 ? Value / Seconds : 0.0;
+	}
+
+	FPsDataBenchmarkResult& AddResult(const TCHAR* Name)
+	{
+		FPsDataBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+		Result.Name = Name;
+		return Result;
+	}
+
+	UPsDataBenchmarkNode* MakeNode(int32 Level)
+	{
+		UPsDataBenchmarkNode* Node = NewObject<UPsDataBenchmarkNode>();
+		++NumNodes;
+
+		Node->SetIntValue(Random.RandHelper(MAX_int32));
+		Node->SetFloatValue(Random.GetFraction());
+		Node->SetBoolValue(Random.RandHelper(2) == 1);
+
+		FString String;
+		for (int32 i = 0; i < Settings.StringLength; ++i)
+		{
+			String.AppendChar(TEXT('a') + Random.RandHelper(26));
+		}
+		Node->SetStringValue(String);
+
+		TArray<int32> Numbers;
+		for (int32 i = 0; i < Settings.Numbers; ++i)
+		{
+			Numbers.Add(Random.RandHelper(MAX_int32));
+		}
+		Node->GetNumbers().Set(Numbers);
+
+		if (Level < Settings.Depth)
+		{
+			for (int32 i = 0; i < Settings.Width; ++i)
+			{
+				UPsDataBenchmarkNode* Child = MakeNode(Level + 1);
+				if (Random.GetFraction() < Settings.MapRatio)
+				{
+					Node->GetMap().Add(FString::Printf(TEXT("Key%d"), i), Child);
+				}
+				else
+				{
+					Node->GetArray().Add(Child);
+				}
+			}
+		}
+
+		return Node;
+	}
+
+	void RunSerialization()
+	{
+		// Binary
+		{
+			FPsDataBenchmarkResult& Write = AddResult(TEXT("BinarySerialize"));
+			FPsDataBenchmarkResult& Read = AddResult(TEXT("BinaryDeserialize"));
+			for (int32 i = 0; i < Settings.Iterations; ++i)
+			{
+				auto OutputStream = MakeShared<FPsDataBufferOutputStream>();
+				{
+					FMeasure Measure(Write);
+					FPsDataBinarySerializer Serializer(OutputStream);
+					Root->DataSerialize(&Serializer);
+				}
+				Write.Bytes += OutputStream->GetBuffer().Num();
+
+				UPsDataBenchmarkNode* Node = NewObject<UPsDataBenchmarkNode>();
+				{
+					FMeasure Measure(Read);
+					FPsDataBinaryDeserializer Deserializer(MakeShared<FPsDataBufferInputStream>(OutputStream->GetBuffer()));
+					Node->DataDeserialize(&Deserializer);
+				}
+				Read.Bytes += OutputStream->GetBuffer().Num();
+			}
+			Write.Operations = Read.Operations = Settings.Iterations;
+		}
+
+		// Json
+		{
+			FPsDataBenchmarkResult& Write = AddResult(TEXT("JsonSerialize"));
+			FPsDataBenchmarkResult& Read = AddResult(TEXT("JsonDeserialize"));
+			for (int32 i = 0; i < Settings.Iterations; ++i)
+			{
+				TSharedPtr<FJsonObject> Json;
+				{
+					FMeasure Measure(Write);
+					FPsDataJsonSerializer Serializer;
+					Root->DataSerialize(&Serializer);
+					Json = Serializer.GetJson();
+				}
+
+				UPsDataBenchmarkNode* Node = NewObject<UPsDataBenchmarkNode>();
+				{
+					FMeasure Measure(Read);
+					FPsDataJsonDeserializer Deserializer(Json);
+					Node->DataDeserialize(&Deserializer);
+				}
+			}
+			Write.Operations = Read.Operations = Settings.Iterations;
+		}
+
+		// Fast json
+		{
+			FPsDataBenchmarkResult& Write = AddResult(TEXT("FastJsonSerialize"));
+			FPsDataBenchmarkResult& Read = AddResult(TEXT("FastJsonDeserialize"));
+			for (int32 i = 0; i < Settings.Iterations; ++i)
+			{
+				FString JsonString;
+				{
+					FMeasure Measure(Write);
+					FPsDataFastJsonSerializer Serializer;
+					Root->DataSerialize(&Serializer);
+					JsonString = MoveTemp(Serializer.JsonString);
+				}
+				Write.Bytes += JsonString.Len() * sizeof(TCHAR);
+
+				UPsDataBenchmarkNode* Node = NewObject<UPsDataBenchmarkNode>();
+				{
+					FMeasure Measure(Read);
+					FPsDataFastJsonDeserializer Deserializer(JsonString);
+					Node->DataDeserialize(&Deserializer);
+				}
+				Read.Bytes += JsonString.Len() * sizeof(TCHAR);
+			}
+			Write.Operations = Read.Operations = Settings.Iterations;
+		}
+
+		// MsgPack
+		{
+			FPsDataBenchmarkResult& Write = AddResult(TEXT("MsgPackSerialize"));
+			FPsDataBenchmarkResult& Read = AddResult(TEXT("MsgPackDeserialize"));
+			for (int32 i = 0; i < Settings.Iterations; ++i)
+			{
+				TArray<uint8> Buffer;
+				{
+					FMeasure Measure(Write);
+					FPsDataMsgPackSerializer Serializer;
+					Root->DataSerialize(&Serializer);
+					Buffer = MoveTemp(Serializer.Buffer);
+				}
+				const int32 NumBytes = Buffer.Num();
+				Write.Bytes += NumBytes;
+
+				UPsDataBenchmarkNode* Node = NewObject<UPsDataBenchmarkNode>();
+				{
+					FMeasure Measure(Read);
+					FPsDataMsgPackDeserializer Deserializer(MoveTemp(Buffer));
+					Node->DataDeserialize(&Deserializer);
+				}
+				Read.Bytes += NumBytes;
+			}
+			Write.Operations = Read.Operations = Settings.Iterations;
+		}
+	}
+
+	void RunCopy()
+	{
+		FPsDataBenchmarkResult& Result = AddResult(TEXT("Copy"));
+		for (int32 i = 0; i < Settings.Iterations; ++i)
+		{
+			FMeasure Measure(Result);
+			Root->Copy();
+		}
+		Result.Operations = Settings.Iterations;
+	}
+
+	void RunHash()
+	{
+		// Every run calculates hash of whole tree
+		FPsDataBenchmarkResult& Result = AddResult(TEXT("GetHash"));
+		for (int32 i = 0; i < Settings.Iterations; ++i)
+		{
+			UPsDataBenchmarkNode* Node = Root->Copy<UPsDataBenchmarkNode>();
+			{
+				FMeasure Measure(Result);
+				Node->GetHash();
+			}
+		}
+		Result.Operations = Settings.Iterations;
+	}
+
+	void RunCollections()
+	{
+		const int32 Count = FMath::Max(Settings.Width, 1) * 16;
+
+		TArray<UPsDataBenchmarkNode*> Elements;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Elements.Add(NewObject<UPsDataBenchmarkNode>());
+		}
+
+		UPsDataBenchmarkNode* Node = NewObject<UPsDataBenchmarkNode>();
+		Node->AddToRoot();
+
+		FPsDataBenchmarkResult& Array = AddResult(TEXT("ArrayAddRemove"));
+		for (int32 i = 0; i < Settings.Iterations; ++i)
+		{
+			FMeasure Measure(Array);
+			for (UPsDataBenchmarkNode* Element : Elements)
+			{
+				Node->GetArray().Add(Element);
+			}
+			while (Node->GetArray().Num() > 0)
+			{
+				Node->GetArray().RemoveAt(Node->GetArray().Num() - 1);
+			}
+		}
+		Array.Operations = static_cast<int64>(Settings.Iterations) * Count * 2;
+
+		FPsDataBenchmarkResult& Map = AddResult(TEXT("MapAddRemove"));
+		for (int32 i = 0; i < Settings.Iterations; ++i)
+		{
+			FMeasure Measure(Map);
+			for (int32 j = 0; j < Count; ++j)
+			{
+				Node->GetMap().Add(FDataReflectionTools::FPsDataFriend::GetIndexName(j), Elements[j]);
+			}
+			for (int32 j = 0; j < Count; ++j)
+			{
+				Node->GetMap().Remove(FDataReflectionTools::FPsDataFriend::GetIndexName(j));
+			}
+		}
+		Map.Operations = static_cast<int64>(Settings.Iterations) * Count * 2;
+
+		Node->RemoveFromRoot();
+		FPsDataChangeDispatcher::Get().Flush();
+	}
+
+	void RunBroadcast()
+	{
+		int32 Calls = 0;
+		FPsDataBindCollection Binds;
+		for (int32 i = 0; i < Settings.Listeners; ++i)
+		{
+			Binds.Add(Root->Bind_IntValueChanged(FPsDataDelegate::CreateLambda([&Calls](UPsDataEvent* Event) {
+				++Calls;
+			})));
+		}
+
+		const int32 Count = Settings.Iterations * 100;
+		FPsDataBenchmarkResult& Result = AddResult(TEXT("SetWithListeners"));
+		{
+			FMeasure Measure(Result);
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Root->SetIntValue(i);
+			}
+			FPsDataEventQueue::Get().Flush();
+			FPsDataChangeDispatcher::Get().Flush();
+		}
+		Result.Operations = Count;
+
+		Binds.Unbind();
+		UE_LOG(LogData, Verbose, TEXT("%d listener calls"), Calls);
+	}
+
+	FPsDataBenchmarkSettings Settings;
+	FRandomStream Random;
+	UPsDataBenchmarkNode* Root;
+	int32 NumNodes;
+	TArray<FPsDataBenchmarkResult> Results;
+};
+
+/***********************************
+ * Console command
+ ***********************************/
+
+static FAutoConsoleCommand PsDataBenchmarkCommand(
+	TEXT("PsData.Benchmark"),
+	TEXT("Benchmark serialization, copy, hash, collections and events on synthetic tree, writes JSON report. ")
+		TEXT("Args: Depth=, Width=, MapRatio=, StringLength=, Numbers=, Listeners=, Iterations=, Seed=, Json=<path>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		const FString Cmd = FString::Join(Args, TEXT(" "));
+
+		FPsDataBenchmarkSettings Settings;
+		FParse::Value(*Cmd, TEXT("Depth="), Settings.Depth);
+		FParse::Value(*Cmd, TEXT("Width="), Settings.Width);
+		FParse::Value(*Cmd, TEXT("MapRatio="), Settings.MapRatio);
+		FParse::Value(*Cmd, TEXT("StringLength="), Settings.StringLength);
+		FParse::Value(*Cmd, TEXT("Numbers="), Settings.Numbers);
+		FParse::Value(*Cmd, TEXT("Listeners="), Settings.Listeners);
+		FParse::Value(*Cmd, TEXT("Iterations="), Settings.Iterations);
+		FParse::Value(*Cmd, TEXT("Seed="), Settings.Seed);
+
+		FString JsonPath = FPaths::ProfilingDir() / TEXT("PsData") / FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString());
+		FParse::Value(*Cmd, TEXT("Json="), JsonPath);
+
+		FPsDataBenchmark Benchmark(Settings);
+		Benchmark.Run();
+		Benchmark.Log();
+
+		if (FFileHelper::SaveStringToFile(Benchmark.ToJson(), *JsonPath))
+		{
+			UE_LOG(LogData, Display, TEXT("Saved %s"), *JsonPath);
+		}
+		else
+		{
+			UE_LOG(LogData, Error, TEXT("Can't save %s"), *JsonPath);
+		}
+	}));
+
+#endif // !UE_BUILD_SHIPPING
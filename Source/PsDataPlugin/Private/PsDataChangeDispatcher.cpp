@@ -0,0 +1,81 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "PsDataChangeDispatcher.h"
+
+#include "PsData.h"
+
+FPsDataChangeDispatcher::FPsDataChangeDispatcher()
+	: FlushMode(EPsDataChangeFlush::EndOfFrame)
+	, FrameBudget(0)
+{
+	Queue.OnDispatch = [](TWeakObjectPtr<UPsData>& WeakPtr) {
+		if (UPsData* Data = WeakPtr.Get())
+		{
+			FDataReflectionTools::FPsDataFriend::DispatchChanged(Data);
+		}
+	};
+
+	Queue.OnDrop = [](TWeakObjectPtr<UPsData>& WeakPtr) {
+		if (UPsData* Data = WeakPtr.Get())
+		{
+			FDataReflectionTools::FPsDataFriend::ResetChanged(Data);
+		}
+	};
+
+	Queue.GetTickCount = [this]() {
+		if (FlushMode != EPsDataChangeFlush::EndOfFrame)
+		{
+			return 0;
+		}
+
+		const int32 Count = Queue.Num();
+		return FrameBudget > 0 ? FMath::Min(Count, FrameBudget) : Count;
+	};
+}
+
+FPsDataChangeDispatcher& FPsDataChangeDispatcher::Get()
+{
+	static FPsDataChangeDispatcher Dispatcher;
+	return Dispatcher;
+}
+
+void FPsDataChangeDispatcher::Add(UPsData* Data)
+{
+	Queue.Add(Data);
+}
+
+void FPsDataChangeDispatcher::Flush()
+{
+	Queue.Flush();
+}
+
+void FPsDataChangeDispatcher::Reset()
+{
+	Queue.Reset();
+}
+
+int32 FPsDataChangeDispatcher::Num() const
+{
+	return Queue.Num();
+}
+
+void FPsDataChangeDispatcher::SetFlushMode(EPsDataChangeFlush Mode)
+{
+	FlushMode = Mode;
+	Queue.UpdateTicker();
+}
+
+EPsDataChangeFlush FPsDataChangeDispatcher::GetFlushMode() const
+{
+	return FlushMode;
+}
+
+void FPsDataChangeDispatcher::SetFrameBudget(int32 Budget)
+{
+	FrameBudget = FMath::Max(Budget, 0);
+}
+
+int32 FPsDataChangeDispatcher::GetFrameBudget() const
+{
+	return FrameBudget;
+}
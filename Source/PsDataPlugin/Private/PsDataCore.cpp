@@ -2,13 +2,76 @@
 
 #include "PsDataCore.h"
 
+#include "PsDataRoot.h"
+#include "Serialize/PsDataBinarySerialization.h"
+#include "Serialize/PsDataFastJsonSerialization.h"
 #include "Types/PsData_FString.h"
 #include "Types/PsData_UPsData.h"
 
+#include "Algo/BinarySearch.h"
 #include "UObject/UObjectIterator.h"
 
+/***********************************
+ * FDataClassLayout
+ ***********************************/
+
+FDataClassLayout::FDataClassLayout()
+	: ClassIndex(INDEX_NONE)
+{
+}
+
+const TSharedPtr<const FDataField>& FDataClassLayout::FindByIndex(int32 Index) const
+{
+	if (Fields.IsValidIndex(Index))
+	{
+		return Fields[Index];
+	}
+
+	static const TSharedPtr<const FDataField> EmptySharedPtr(nullptr);
+	return EmptySharedPtr;
+}
+
+const TSharedPtr<const FDataField>& FDataClassLayout::FindByHash(int32 Hash) const
+{
+	const int32 SortedIndex = Algo::BinarySearch(Hashes, Hash);
+	if (SortedIndex != INDEX_NONE)
+	{
+		return Fields[HashIndices[SortedIndex]];
+	}
+
+	static const TSharedPtr<const FDataField> EmptySharedPtr(nullptr);
+	return EmptySharedPtr;
+}
+
+const TSharedPtr<const FDataField>& FDataClassLayout::FindByName(const FString& Name) const
+{
+	const TSharedPtr<const FDataField>& Field = FindByHash(NameHash(Name));
+	if (Field.IsValid() && Field->Name.Equals(Name, ESearchCase::CaseSensitive))
+	{
+		return Field;
+	}
+
+	static const TSharedPtr<const FDataField> EmptySharedPtr(nullptr);
+	return EmptySharedPtr;
+}
+
+int32 FDataClassLayout::NameHash(const FString& Name)
+{
+	uint32 Crc = 0xFFFFFFFF;
+	for (const TCHAR Char : Name)
+	{
+		Crc = FDataReflectionTools::crc32_table[static_cast<uint8>(Crc) ^ static_cast<uint8>(Char)] ^ (Crc >> 8);
+	}
+	return static_cast<int32>(Crc ^ 0xFFFFFFFF);
+}
+
+/***********************************
+ * FDataReflection
+ ***********************************/
+
 TMap<UClass*, FDataClassFields> FDataReflection::FieldsByClass;
-TMap<FString, const TArray<FString>> FDataReflection::SplittedPath;
+TMap<const UClass*, int32> FDataReflection::LayoutIndices;
+TArray<FDataClassLayout> FDataReflection::Layouts;
 TArray<const char*> FDataReflection::MetaCollection;
 bool FDataReflection::bCompiled = false;
 
@@ -196,18 +259,6 @@ void FDataReflection::Fill(UPsData* Instance)
 	}
 }
 
-const TArray<FString>& FDataReflection::SplitPath(const FString& Path)
-{
-	if (auto Find = SplittedPath.Find(Path))
-	{
-		return *Find;
-	}
-
-	TArray<FString> PathArray;
-	Path.ParseIntoArray(PathArray, TEXT("."));
-	return SplittedPath.Add(Path, std::move(PathArray));
-}
-
 const TSharedPtr<const FDataField>& FDataReflection::GetFieldByName(UClass* OwnerClass, const FString& Name)
 {
 	if (auto MapPtr = FieldsByClass.Find(OwnerClass))
@@ -250,6 +301,49 @@ const TSharedPtr<const FDataField>& FDataReflection::GetFieldByHash(UClass* Owne
 	return EmptySharedPtr;
 }
 
+const TSharedPtr<const FDataField>& FDataReflection::GetFieldByName(const UPsData* Instance, const FString& Name)
+{
+	if (const FDataClassLayout* Layout = FDataReflectionTools::FPsDataFriend::GetLayout(Instance))
+	{
+		const TSharedPtr<const FDataField>& Field = Layout->FindByName(Name);
+		if (Field.IsValid())
+		{
+			return Field;
+		}
+	}
+
+	return GetFieldByName(Instance->GetClass(), Name);
+}
+
+const TSharedPtr<const FDataField>& FDataReflection::GetFieldByHash(const UPsData* Instance, int32 Hash)
+{
+	if (const FDataClassLayout* Layout = FDataReflectionTools::FPsDataFriend::GetLayout(Instance))
+	{
+		return Layout->FindByHash(Hash);
+	}
+
+	return GetFieldByHash(Instance->GetClass(), Hash);
+}
+
+const TSharedPtr<const FDataField>& FDataReflection::GetFieldByIndex(const UPsData* Instance, int32 Index)
+{
+	if (const FDataClassLayout* Layout = FDataReflectionTools::FPsDataFriend::GetLayout(Instance))
+	{
+		return Layout->FindByIndex(Index);
+	}
+
+	for (const auto& Pair : GetFields(Instance->GetClass()))
+	{
+		if (Pair.Value->Index == Index)
+		{
+			return Pair.Value;
+		}
+	}
+
+	static const TSharedPtr<const FDataField> EmptySharedPtr(nullptr);
+	return EmptySharedPtr;
+}
+
 const TMap<FString, const TSharedPtr<const FDataField>>& FDataReflection::GetFields(const UClass* OwnerClass)
 {
 	auto Find = FieldsByClass.Find(OwnerClass);
@@ -274,6 +368,32 @@ const TMap<FString, const TSharedPtr<const FDataField>>& FDataReflection::GetAli
 	return Empty;
 }
 
+const FPsDataClassPlan* FDataReflection::GetClassPlan(const UClass* OwnerClass)
+{
+	if (!bCompiled)
+	{
+		return nullptr;
+	}
+
+	auto Find = FieldsByClass.Find(OwnerClass);
+	if (Find)
+	{
+		return &Find->Plan;
+	}
+
+	return nullptr;
+}
+
+const FDataClassLayout* FDataReflection::GetClassLayout(const UClass* OwnerClass)
+{
+	if (const int32* Find = LayoutIndices.Find(OwnerClass))
+	{
+		return &Layouts[*Find];
+	}
+
+	return nullptr;
+}
+
 const TSharedPtr<const FDataLink>& FDataReflection::GetLinkByName(UClass* OwnerClass, const FString& Name)
 {
 	if (auto MapPtr = FieldsByClass.Find(OwnerClass))
@@ -314,6 +434,18 @@ const TMap<FString, const TSharedPtr<const FDataLink>>& FDataReflection::GetLink
 	return Empty;
 }
 
+const FPsDataPath* FDataReflection::FindPath(const UClass* OwnerClass, const FString& Path)
+{
+	const FDataClassFields* Fields = FieldsByClass.Find(const_cast<UClass*>(OwnerClass));
+	if (Fields == nullptr || Fields->Paths.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const TSharedPtr<const FPsDataPath>* Find = Fields->Paths.Find(Path);
+	return Find ? Find->Get() : nullptr;
+}
+
 bool FDataReflection::HasClass(const UClass* OwnerClass)
 {
 	return FieldsByClass.Contains(OwnerClass);
@@ -360,4 +492,298 @@ void FDataReflection::Compile()
 			}
 		}
 	}
+
+	for (auto& MapPair : FieldsByClass)
+	{
+		auto& Plan = MapPair.Value.Plan;
+		Plan.Entries.Reset(MapPair.Value.FieldsByAlias.Num());
+		Plan.EntryIndices.Reset();
+		for (auto& Pair : MapPair.Value.FieldsByAlias)
+		{
+			Plan.EntryIndices.Add(Pair.Key, Plan.Entries.Num());
+
+			FPsDataClassPlanEntry& Entry = Plan.Entries.AddDefaulted_GetRef();
+			Entry.Alias = Pair.Key;
+			Entry.BinaryKey = FPsDataBinarySerializer::EncodeKey(Pair.Key);
+			Entry.JsonKey = FPsDataFastJsonSerializer::EncodeKey(Pair.Key);
+			Entry.Index = Pair.Value->Index;
+			Entry.TypeHash = Pair.Value->Context->GetHash();
+			Entry.Field = Pair.Value.Get();
+		}
+	}
+
+	Layouts.Reset(FieldsByClass.Num());
+	LayoutIndices.Reset();
+	for (auto& MapPair : FieldsByClass)
+	{
+		FDataClassLayout& Layout = Layouts.AddDefaulted_GetRef();
+		Layout.ClassIndex = Layouts.Num() - 1;
+		LayoutIndices.Add(MapPair.Key, Layout.ClassIndex);
+
+		const auto& FieldsByHash = MapPair.Value.FieldsByHash;
+		Layout.Fields.SetNum(FieldsByHash.Num());
+		Layout.HashIndices.Reserve(FieldsByHash.Num());
+		for (auto& Pair : FieldsByHash)
+		{
+			check(!Layout.Fields[Pair.Value->Index].IsValid());
+			Layout.Fields[Pair.Value->Index] = Pair.Value;
+			Layout.HashIndices.Add(Pair.Value->Index);
+		}
+
+		Layout.HashIndices.Sort([&Layout](const int32 A, const int32 B) {
+			return Layout.Fields[A]->Hash < Layout.Fields[B]->Hash;
+		});
+
+		Layout.Hashes.Reserve(FieldsByHash.Num());
+		for (const int32 Index : Layout.HashIndices)
+		{
+			Layout.Hashes.Add(Layout.Fields[Index]->Hash);
+		}
+
+#if !UE_BUILD_SHIPPING
+		for (auto& Pair : MapPair.Value.FieldsByName)
+		{
+			if (FDataClassLayout::NameHash(Pair.Key) != Pair.Value->Hash)
+			{
+				UE_LOG(LogData, Warning, TEXT("Property hash of %s::%s doesn't match name"), *MapPair.Key->GetName(), *Pair.Key);
+			}
+		}
+#endif
+	}
+
+	TSet<FString> LinkPaths;
+	TArray<UClass*> RootClasses;
+	TArray<const UClass*> Classes;
+	for (auto& MapPair : FieldsByClass)
+	{
+		Classes.Add(MapPair.Key);
+
+		for (auto& Pair : MapPair.Value.LinksByName)
+		{
+			if (!Pair.Value->bPathProperty)
+			{
+				LinkPaths.Add(Pair.Value->Path);
+			}
+		}
+
+		if (MapPair.Key->IsChildOf(UPsDataRoot::StaticClass()))
+		{
+			RootClasses.Add(MapPair.Key);
+		}
+	}
+
+	// Link is resolved from root, so its path is compiled against every root class having its first property
+	for (const FString& LinkPath : LinkPaths)
+	{
+		FString FirstSegment;
+		if (!LinkPath.Split(TEXT("."), &FirstSegment, nullptr))
+		{
+			FirstSegment = LinkPath;
+		}
+
+		for (UClass* RootClass : RootClasses)
+		{
+			if (GetFieldByName(RootClass, FirstSegment).IsValid())
+			{
+				TSharedRef<FPsDataPath> Path = MakeShared<FPsDataPath>(RootClass, LinkPath);
+				Path->CompileTails(Classes);
+				FieldsByClass.FindChecked(RootClass).Paths.Add(LinkPath, Path);
+			}
+		}
+	}
+}
+
+/***********************************
+ * FPsDataPath
+ ***********************************/
+
+FPsDataPathStep::FPsDataPathStep()
+	: Field(nullptr)
+	, Element(EPsDataPathElement::None)
+	, ArrayIndex(INDEX_NONE)
+{
+}
+
+FPsDataPath::FPsDataPath()
+	: Class(nullptr)
+	, TailClass(nullptr)
+{
+}
+
+FPsDataPath::FPsDataPath(const UClass* InClass, const FString& InPath)
+	: Class(InClass)
+	, Path(InPath)
+	, TailClass(nullptr)
+{
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("."));
+
+	UClass* StepClass = const_cast<UClass*>(Class);
+	int32 SegmentIndex = 0;
+	while (SegmentIndex < Segments.Num())
+	{
+		const auto& Field = FDataReflection::GetFieldByName(StepClass, Segments[SegmentIndex]);
+		if (!Field.IsValid() && Steps.Num() > 0)
+		{
+			// Property may belong to a child class, resolved against runtime class of owner
+			Tail = FString::Join(TArrayView<const FString>(Segments).Slice(SegmentIndex, Segments.Num() - SegmentIndex), TEXT("."));
+			TailClass = StepClass;
+			return;
+		}
+
+		if (!Field.IsValid())
+		{
+			UE_LOG(LogData, Error, TEXT("Can't find property \"%s\" of path \"%s\" in \"%s\""), *Segments[SegmentIndex], *Path, *GetNameSafe(Class));
+			Steps.Reset();
+			return;
+		}
+
+		++SegmentIndex;
+
+		FPsDataPathStep& Step = Steps.AddDefaulted_GetRef();
+		Step.Field = Field;
+
+		if (SegmentIndex < Segments.Num())
+		{
+			if (Field->Context->IsArray())
+			{
+				const FString& Segment = Segments[SegmentIndex];
+				if (!Segment.IsNumeric())
+				{
+					UE_LOG(LogData, Error, TEXT("Can't use \"%s\" of path \"%s\" as index"), *Segment, *Path);
+					Steps.Reset();
+					return;
+				}
+
+				Step.Element = EPsDataPathElement::ArrayIndex;
+				Step.ArrayIndex = FCString::Atoi(*Segment);
+				++SegmentIndex;
+			}
+			else if (Field->Context->IsMap())
+			{
+				Step.Element = EPsDataPathElement::MapKey;
+				Step.Key = Segments[SegmentIndex];
+				++SegmentIndex;
+			}
+		}
+
+		if (SegmentIndex < Segments.Num())
+		{
+			StepClass = Field->Context->IsData() ? Cast<UClass>(Field->Context->GetUE4Type()) : nullptr;
+			if (StepClass == nullptr)
+			{
+				UE_LOG(LogData, Error, TEXT("Can't use property \"%s\" of path \"%s\" without children"), *Field->Name, *Path);
+				Steps.Reset();
+				return;
+			}
+		}
+	}
+}
+
+bool FPsDataPath::IsValid() const
+{
+	return Steps.Num() > 0;
+}
+
+const UClass* FPsDataPath::GetClass() const
+{
+	return Class;
+}
+
+const FString& FPsDataPath::GetPath() const
+{
+	return Path;
+}
+
+UPsData* FPsDataPath::GetOwner(UPsData* Instance) const
+{
+	UPsData* Owner = Instance;
+	const int32 NumOwnerSteps = Tail.IsEmpty() ? Steps.Num() - 1 : Steps.Num();
+	for (int32 i = 0; i < NumOwnerSteps && Owner != nullptr; ++i)
+	{
+		const FPsDataPathStep& Step = Steps[i];
+		if (Step.Element == EPsDataPathElement::None)
+		{
+			UPsData** DataPtr = nullptr;
+			Owner = FDataReflectionTools::GetByField(Owner, Step.Field, DataPtr) ? *DataPtr : nullptr;
+		}
+		else if (Step.Element == EPsDataPathElement::ArrayIndex)
+		{
+			TArray<UPsData*>* ArrayPtr = nullptr;
+			if (FDataReflectionTools::GetByField(Owner, Step.Field, ArrayPtr) && ArrayPtr->IsValidIndex(Step.ArrayIndex))
+			{
+				Owner = (*ArrayPtr)[Step.ArrayIndex];
+			}
+			else
+			{
+				check(false && "Can't find property by index");
+				Owner = nullptr;
+			}
+		}
+		else
+		{
+			TMap<FString, UPsData*>* MapPtr = nullptr;
+			UPsData** DataPtr = FDataReflectionTools::GetByField(Owner, Step.Field, MapPtr) ? MapPtr->Find(Step.Key) : nullptr;
+			check(DataPtr && "Can't find property by name");
+			Owner = DataPtr ? *DataPtr : nullptr;
+		}
+	}
+
+	check(Owner && "Can't use nullptr property");
+	return Owner;
+}
+
+UPsData* FPsDataPath::GetPropertyOwner(UPsData* Instance, TSharedPtr<const FDataField>& OutField) const
+{
+	UPsData* Owner = GetOwner(Instance);
+	if (Owner == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (!Tail.IsEmpty())
+	{
+		const TSharedPtr<const FPsDataPath> TailPath = GetTailPath(Owner);
+		return TailPath.IsValid() ? TailPath->GetPropertyOwner(Owner, OutField) : nullptr;
+	}
+
+	OutField = Steps.Last().Field;
+	return Owner;
+}
+
+TSharedPtr<const FPsDataPath> FPsDataPath::GetTailPath(UPsData* Owner) const
+{
+	const UClass* OwnerClass = Owner->GetClass();
+	if (const TSharedPtr<const FPsDataPath>* Find = TailPaths.Find(OwnerClass))
+	{
+		return *Find;
+	}
+
+	TSharedPtr<const FPsDataPath> TailPath = MakeShared<const FPsDataPath>(OwnerClass, Tail);
+	return TailPath->IsValid() ? TailPath : nullptr;
+}
+
+void FPsDataPath::CompileTails(const TArray<const UClass*>& Classes)
+{
+	if (Tail.IsEmpty())
+	{
+		return;
+	}
+
+	FString FirstSegment;
+	if (!Tail.Split(TEXT("."), &FirstSegment, nullptr))
+	{
+		FirstSegment = Tail;
+	}
+
+	// Classes without the property are left out, so tail isn't reported as invalid for them on compile
+	for (const UClass* OwnerClass : Classes)
+	{
+		if (OwnerClass->IsChildOf(TailClass) && FDataReflection::GetFieldByName(const_cast<UClass*>(OwnerClass), FirstSegment).IsValid())
+		{
+			TSharedRef<FPsDataPath> TailPath = MakeShared<FPsDataPath>(OwnerClass, Tail);
+			TailPath->CompileTails(Classes);
+			TailPaths.Add(OwnerClass, TailPath);
+		}
+	}
 }
@@ -11,14 +11,34 @@ const FString UPsDataEvent::Added(TEXT("Added"));
 const FString UPsDataEvent::Removing(TEXT("Removing"));
 const FString UPsDataEvent::Changed(TEXT("Changed"));
 const FString UPsDataEvent::NameChanged(TEXT("NameChanged"));
+const FString UPsDataEvent::ElementAdded(TEXT("ElementAdded"));
+const FString UPsDataEvent::ElementRemoved(TEXT("ElementRemoved"));
+const FString UPsDataEvent::ElementChanged(TEXT("ElementChanged"));
+
+const FName UPsDataEvent::AddedId(TEXT("Added"));
+const FName UPsDataEvent::RemovingId(TEXT("Removing"));
+const FName UPsDataEvent::ChangedId(TEXT("Changed"));
+const FName UPsDataEvent::NameChangedId(TEXT("NameChanged"));
+const FName UPsDataEvent::ElementAddedId(TEXT("ElementAdded"));
+const FName UPsDataEvent::ElementRemovedId(TEXT("ElementRemoved"));
+const FName UPsDataEvent::ElementChangedId(TEXT("ElementChanged"));
+
+TArray<UPsDataEvent*> UPsDataEvent::Pool;
+
+/** Max number of free events in pool */
+static constexpr int32 MaxPoolSize = 64;
 
 UPsDataEvent::UPsDataEvent(const class FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, Type(TEXT("Unknown"))
+	, TypeId(TEXT("Unknown"))
 	, Target(nullptr)
 	, bBubbles(false)
 	, bStopImmediate(false)
 	, bStop(false)
+	, Index(INDEX_NONE)
+	, Bubbled(nullptr)
+	, bRetained(false)
 {
 }
 
@@ -27,11 +47,53 @@ UPsDataEvent* UPsDataEvent::ConstructEvent(FString EventType, bool bEventBubbles
 	UPsDataEvent* Event = NewObject<UPsDataEvent>();
 
 	Event->Type = EventType;
+	Event->TypeId = FName(*EventType);
 	Event->bBubbles = bEventBubbles;
 
 	return Event;
 }
 
+UPsDataEvent* UPsDataEvent::Acquire(FName EventType, bool bEventBubbles)
+{
+	check(IsInGameThread());
+
+	UPsDataEvent* Event = nullptr;
+	if (Pool.Num() > 0)
+	{
+		Event = Pool.Pop(false);
+	}
+	else
+	{
+		Event = NewObject<UPsDataEvent>();
+		Event->AddToRoot();
+	}
+
+	Event->Type.Reset();
+	Event->TypeId = EventType;
+	Event->bBubbles = bEventBubbles;
+
+	return Event;
+}
+
+void UPsDataEvent::Release(UPsDataEvent* Event)
+{
+	if (Event->bRetained || Pool.Num() >= MaxPoolSize)
+	{
+		Event->Field.Reset();
+		Event->Bubbled = nullptr;
+		Event->RemoveFromRoot();
+		return;
+	}
+
+	Event->Target = nullptr;
+	Event->bStopImmediate = false;
+	Event->bStop = false;
+	Event->Index = INDEX_NONE;
+	Event->Field.Reset();
+	Event->Bubbled = nullptr;
+	Pool.Add(Event);
+}
+
 const UPsData* UPsDataEvent::GetTarget() const
 {
 	return Target;
@@ -39,14 +101,33 @@ const UPsData* UPsDataEvent::GetTarget() const
 
 const FString& UPsDataEvent::GetType() const
 {
+	if (Type.IsEmpty())
+	{
+		TypeId.ToString(Type);
+	}
 	return Type;
 }
 
+FName UPsDataEvent::GetTypeId() const
+{
+	return TypeId;
+}
+
 bool UPsDataEvent::IsBubbles() const
 {
 	return bBubbles;
 }
 
+int32 UPsDataEvent::GetIndex() const
+{
+	return Index;
+}
+
+TSharedPtr<const FDataField> UPsDataEvent::GetField() const
+{
+	return Field;
+}
+
 void UPsDataEvent::StopImmediatePropagation()
 {
 	bStopImmediate = true;
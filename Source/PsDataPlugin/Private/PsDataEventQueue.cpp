@@ -0,0 +1,157 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "PsDataEventQueue.h"
+
+#include "PsData.h"
+#include "PsDataEvent.h"
+
+FPsDataEventQueue::FPsDataEventQueue()
+	: Mode(EPsDataEventProcessing::Immediate)
+	, FrameBudget(256)
+	, bMergeDuplicates(false)
+{
+	Queue.OnDispatch = [this](FEntry& Entry) {
+		if (bMergeDuplicates)
+		{
+			PendingKeys.Remove(Entry.Key);
+		}
+
+		if (UPsData* Target = Entry.Target.Get())
+		{
+			FDataReflectionTools::FPsDataFriend::DispatchEvent(Target, Entry.Event);
+		}
+		Free(Entry.Event, Entry.bPooled);
+	};
+
+	Queue.OnDrop = [](FEntry& Entry) {
+		Free(Entry.Event, Entry.bPooled);
+	};
+
+	Queue.GetTickCount = [this]() {
+		switch (Mode)
+		{
+		case EPsDataEventProcessing::EndOfFrame:
+			return Queue.Num();
+		case EPsDataEventProcessing::Budgeted:
+			return FMath::Min(Queue.Num(), FrameBudget);
+		default:
+			return 0;
+		}
+	};
+}
+
+FPsDataEventQueue& FPsDataEventQueue::Get()
+{
+	static FPsDataEventQueue Queue;
+	return Queue;
+}
+
+void FPsDataEventQueue::Broadcast(const UPsData* Target, UPsDataEvent* Event, bool bPooled)
+{
+	if (Mode == EPsDataEventProcessing::Immediate)
+	{
+		FDataReflectionTools::FPsDataFriend::DispatchEvent(Target, Event);
+		if (bPooled)
+		{
+			UPsDataEvent::Release(Event);
+		}
+		return;
+	}
+
+	// Coalescing set of transaction doesn't live until dispatch, so bubbling isn't deduplicated per parent
+	Event->Bubbled = nullptr;
+
+	const FEntryKey Key = MakeKey(Target, Event);
+	if (bMergeDuplicates)
+	{
+		bool bAlreadyQueued = false;
+		PendingKeys.Add(Key, &bAlreadyQueued);
+		if (bAlreadyQueued)
+		{
+			if (bPooled)
+			{
+				UPsDataEvent::Release(Event);
+			}
+			return;
+		}
+	}
+
+	if (!bPooled)
+	{
+		Event->AddToRoot();
+	}
+
+	Queue.Add({const_cast<UPsData*>(Target), Event, Key, bPooled});
+}
+
+void FPsDataEventQueue::Flush()
+{
+	Queue.Flush();
+}
+
+void FPsDataEventQueue::Reset()
+{
+	Queue.Reset();
+	PendingKeys.Empty();
+}
+
+int32 FPsDataEventQueue::Num() const
+{
+	return Queue.Num();
+}
+
+void FPsDataEventQueue::SetMode(EPsDataEventProcessing InMode)
+{
+	Mode = InMode;
+	if (Mode == EPsDataEventProcessing::Immediate)
+	{
+		Flush();
+	}
+	Queue.UpdateTicker();
+}
+
+EPsDataEventProcessing FPsDataEventQueue::GetMode() const
+{
+	return Mode;
+}
+
+void FPsDataEventQueue::SetFrameBudget(int32 Budget)
+{
+	FrameBudget = FMath::Max(Budget, 1);
+}
+
+int32 FPsDataEventQueue::GetFrameBudget() const
+{
+	return FrameBudget;
+}
+
+void FPsDataEventQueue::SetMergeDuplicates(bool bMerge)
+{
+	bMergeDuplicates = bMerge;
+	if (!bMergeDuplicates)
+	{
+		PendingKeys.Empty();
+	}
+}
+
+bool FPsDataEventQueue::IsMergeDuplicates() const
+{
+	return bMergeDuplicates;
+}
+
+void FPsDataEventQueue::Free(UPsDataEvent* Event, bool bPooled)
+{
+	if (bPooled)
+	{
+		UPsDataEvent::Release(Event);
+	}
+	else
+	{
+		Event->RemoveFromRoot();
+	}
+}
+
+FPsDataEventQueue::FEntryKey FPsDataEventQueue::MakeKey(const UPsData* Target, const UPsDataEvent* Event)
+{
+	return FEntryKey(Target, Event->GetTypeId(), Event->GetIndex(), Event->GetField().Get());
+}
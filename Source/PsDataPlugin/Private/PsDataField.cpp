@@ -16,6 +16,7 @@ const char* EDataMetaType::Alias = "alias";
 const char* EDataMetaType::ReadOnly = "readonly";
 const char* EDataMetaType::Deprecated = "deprecated";
 const char* EDataMetaType::Nullable = "nullable";
+const char* EDataMetaType::Index = "index";
 
 /***********************************
  * FDataFieldMeta
@@ -28,6 +29,7 @@ FDataFieldMeta::FDataFieldMeta()
 	, bDeprecated(false)
 	, bReadOnly(false)
 	, bAlias(false)
+	, bIndex(false)
 	, Alias()
 	, EventType()
 {
@@ -300,6 +302,11 @@ void ParseMetaPair(FDataField* Field, const char* Key, int32 KeySize, const char
 		ensureMsgf(Value == nullptr, TEXT("Unused value!"));
 		Field->Meta.bReadOnly = true;
 	}
+	else if (Equal(Key, EDataMetaType::Index))
+	{
+		ensureMsgf(Value == nullptr, TEXT("Unused value!"));
+		Field->Meta.bIndex = true;
+	}
 	else
 	{
 		bError = true;
@@ -424,6 +431,7 @@ FDataField::FDataField(const FString& InName, int32 InIndex, int32 InHash, FAbst
 	, Context(InContext)
 {
 	ParseMeta<FDataField>(this, MetaCollection);
+	ChangedEventId = Meta.EventType.IsEmpty() ? NAME_None : FName(*Meta.EventType);
 }
 
 const FString& FDataField::GetChangedEventName() const
@@ -431,6 +439,11 @@ const FString& FDataField::GetChangedEventName() const
 	return Meta.EventType;
 }
 
+FName FDataField::GetChangedEventId() const
+{
+	return ChangedEventId;
+}
+
 /***********************************
  * FDataLink
  ***********************************/
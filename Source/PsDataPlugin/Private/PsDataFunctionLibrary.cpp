@@ -7,11 +7,15 @@
 #include "PsData.h"
 #include "PsDataCore.h"
 #include "PsDataRoot.h"
+#include "PsDataStats.h"
+#include "PsDataTransaction.h"
 #include "Types/PsData_FName.h"
 #include "Types/PsData_FString.h"
 #include "Types/PsData_UPsData.h"
 #include "Types/PsData_uint8.h"
 
+#include "Containers/Ticker.h"
+
 /***********************************
  * Link
  ***********************************/
@@ -135,8 +139,52 @@ void UPsDataFunctionLibrary::GetLinkKeys(const UPsData* ConstTarget, TSharedPtr<
 	UE_LOG(LogData, Fatal, TEXT("Can't find property \"%s\" in \"%s\""), *Field->Name, *Target->GetClass()->GetName());
 }
 
+TMap<FString, UPsData*>* UPsDataFunctionLibrary::GetLinkCollection(const UPsData* ConstTarget, TSharedPtr<const FDataLink> Link)
+{
+	UPsData* Owner = nullptr;
+	TSharedPtr<const FDataField> Field;
+	return GetLinkCollection(ConstTarget, Link, Owner, Field);
+}
+
+TMap<FString, UPsData*>* UPsDataFunctionLibrary::GetLinkCollection(const UPsData* ConstTarget, TSharedPtr<const FDataLink> Link, UPsData*& OutOwner, TSharedPtr<const FDataField>& OutField)
+{
+	OutOwner = nullptr;
+
+	UPsData* RootData = ConstTarget->GetRoot();
+	if (RootData == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Path of path property link is dynamic, so it's parsed in place instead of caching every value
+	const FString& LinkPath = Link->bPathProperty ? GetLinkPath(ConstTarget, Link) : Link->Path;
+	const FPsDataPath* CompiledPath = Link->bPathProperty ? nullptr : FDataReflection::FindPath(RootData->GetClass(), LinkPath);
+	const FPsDataPath ParsedPath = CompiledPath ? FPsDataPath() : FPsDataPath(RootData->GetClass(), LinkPath);
+	const FPsDataPath& Path = CompiledPath ? *CompiledPath : ParsedPath;
+	if (!Path.IsValid())
+	{
+		return nullptr;
+	}
+
+	TMap<FString, UPsData*>* MapPtr = nullptr;
+	UPsData* Owner = Path.GetPropertyOwner(RootData, OutField);
+	if (Owner && FDataReflectionTools::GetByField(Owner, OutField, MapPtr))
+	{
+		OutOwner = Owner;
+		return MapPtr;
+	}
+	return nullptr;
+}
+
 UPsData* UPsDataFunctionLibrary::GetDataByLinkHash(const UPsData* ConstTarget, int32 Hash)
 {
+	PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataResolveLink);
+
+	if (const TArray<UPsData*>* Cache = FDataReflectionTools::FPsDataFriend::FindLinkCache(ConstTarget, Hash))
+	{
+		return (*Cache)[0];
+	}
+
 	//TODO: PS-136
 	UPsData* Target = const_cast<UPsData*>(ConstTarget);
 	TSharedPtr<const FDataLink> Link = FDataReflection::GetLinkByHash(Target->GetClass(), Hash);
@@ -146,19 +194,20 @@ UPsData* UPsDataFunctionLibrary::GetDataByLinkHash(const UPsData* ConstTarget, i
 	TArray<FString> Keys;
 	GetLinkKeys(ConstTarget, Link, Keys);
 
-	auto RootData = Target->GetRoot();
-	check(RootData);
+	check(Target->GetRoot());
 
-	const FString& LinkPath = GetLinkPath(ConstTarget, Link);
-	TMap<FString, UPsData*>* MapPtr = nullptr;
-	if (!FDataReflectionTools::GetByPath<TMap<FString, UPsData*>>(RootData, LinkPath, MapPtr))
+	UPsData* CollectionOwner = nullptr;
+	TSharedPtr<const FDataField> CollectionField;
+	TMap<FString, UPsData*>* MapPtr = GetLinkCollection(ConstTarget, Link, CollectionOwner, CollectionField);
+	if (MapPtr == nullptr)
 	{
-		UE_LOG(LogData, Fatal, TEXT("Can't find path \"%s\" in \"%s\""), *LinkPath, *Target->GetClass()->GetName())
+		UE_LOG(LogData, Fatal, TEXT("Can't find path \"%s\" in \"%s\""), *GetLinkPath(ConstTarget, Link), *Target->GetClass()->GetName())
 	}
 
 	UPsData** Find = MapPtr->Find(Keys[0]);
 	if (Find)
 	{
+		FDataReflectionTools::FPsDataFriend::SetLinkCache(ConstTarget, Hash, {*Find}, CollectionOwner, CollectionField);
 		return *Find;
 	}
 
@@ -167,11 +216,19 @@ UPsData* UPsDataFunctionLibrary::GetDataByLinkHash(const UPsData* ConstTarget, i
 		UE_LOG(LogData, Fatal, TEXT("Link without Nullable meta can't be nullptr"))
 	}
 
+	FDataReflectionTools::FPsDataFriend::SetLinkCache(ConstTarget, Hash, {nullptr}, CollectionOwner, CollectionField);
 	return nullptr;
 }
 
 TArray<UPsData*> UPsDataFunctionLibrary::GetDataArrayByLinkHash(const UPsData* ConstTarget, int32 Hash)
 {
+	PSDATA_SCOPE_CYCLE_COUNTER(STAT_PsDataResolveLink);
+
+	if (const TArray<UPsData*>* Cache = FDataReflectionTools::FPsDataFriend::FindLinkCache(ConstTarget, Hash))
+	{
+		return *Cache;
+	}
+
 	//TODO: PS-136
 	UPsData* Target = const_cast<UPsData*>(ConstTarget);
 	TSharedPtr<const FDataLink> Link = FDataReflection::GetLinkByHash(Target->GetClass(), Hash);
@@ -181,14 +238,14 @@ TArray<UPsData*> UPsDataFunctionLibrary::GetDataArrayByLinkHash(const UPsData* C
 	TArray<FString> Keys;
 	GetLinkKeys(ConstTarget, Link, Keys);
 
-	auto RootData = Target->GetRoot();
-	check(RootData);
+	check(Target->GetRoot());
 
-	const FString& LinkPath = GetLinkPath(ConstTarget, Link);
-	TMap<FString, UPsData*>* MapPtr = nullptr;
-	if (!FDataReflectionTools::GetByPath<TMap<FString, UPsData*>>(RootData, LinkPath, MapPtr))
+	UPsData* CollectionOwner = nullptr;
+	TSharedPtr<const FDataField> CollectionField;
+	TMap<FString, UPsData*>* MapPtr = GetLinkCollection(ConstTarget, Link, CollectionOwner, CollectionField);
+	if (MapPtr == nullptr)
 	{
-		UE_LOG(LogData, Fatal, TEXT("Can't find path \"%s\" in \"%s\""), *LinkPath, *Target->GetClass()->GetName())
+		UE_LOG(LogData, Fatal, TEXT("Can't find path \"%s\" in \"%s\""), *GetLinkPath(ConstTarget, Link), *Target->GetClass()->GetName())
 	}
 
 	TArray<UPsData*> Result;
@@ -208,6 +265,8 @@ TArray<UPsData*> UPsDataFunctionLibrary::GetDataArrayByLinkHash(const UPsData* C
 			UE_LOG(LogData, Fatal, TEXT("Link without Nullable meta can't be nullptr"))
 		}
 	}
+
+	FDataReflectionTools::FPsDataFriend::SetLinkCache(ConstTarget, Hash, Result, CollectionOwner, CollectionField);
 	return Result;
 }
 
@@ -242,7 +301,7 @@ UPsDataBlueprintMapProxy* UPsDataFunctionLibrary::GetMapProxy(UPsData* Target, i
 {
 	//TODO: Always NewObject?
 	UPsDataBlueprintMapProxy* Result = NewObject<UPsDataBlueprintMapProxy>();
-	Result->Init(Target, FDataReflection::GetFieldByHash(Target->GetClass(), Crc32));
+	Result->Init(Target, FDataReflection::GetFieldByHash(Target, Crc32));
 	return Result;
 }
 
@@ -250,6 +309,60 @@ UPsDataBlueprintArrayProxy* UPsDataFunctionLibrary::GetArrayProxy(UPsData* Targe
 {
 	//TODO: Always NewObject?
 	UPsDataBlueprintArrayProxy* Result = NewObject<UPsDataBlueprintArrayProxy>();
-	Result->Init(Target, FDataReflection::GetFieldByHash(Target->GetClass(), Crc32));
+	Result->Init(Target, FDataReflection::GetFieldByHash(Target, Crc32));
 	return Result;
 }
+
+/***********************************
+ * Transaction
+ ***********************************/
+
+TArray<TUniquePtr<FPsDataTransaction>> UPsDataFunctionLibrary::Transactions;
+FDelegateHandle UPsDataFunctionLibrary::TransactionTickerHandle;
+
+void UPsDataFunctionLibrary::BeginTransaction()
+{
+	Transactions.Add(MakeUnique<FPsDataTransaction>());
+
+	if (!TransactionTickerHandle.IsValid())
+	{
+		TransactionTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&UPsDataFunctionLibrary::CommitLeakedTransactions));
+	}
+}
+
+bool UPsDataFunctionLibrary::CommitLeakedTransactions(float DeltaTime)
+{
+	if (Transactions.Num() > 0)
+	{
+		UE_LOG(LogData, Warning, TEXT("%d transaction(s) started by BeginTransaction weren't finished in frame, committed"), Transactions.Num());
+		while (Transactions.Num() > 0)
+		{
+			Transactions.Pop()->Commit();
+		}
+	}
+
+	TransactionTickerHandle.Reset();
+	return false;
+}
+
+void UPsDataFunctionLibrary::CommitTransaction()
+{
+	if (Transactions.Num() == 0)
+	{
+		UE_LOG(LogData, Error, TEXT("No transaction to commit"));
+		return;
+	}
+
+	Transactions.Pop()->Commit();
+}
+
+void UPsDataFunctionLibrary::RollbackTransaction()
+{
+	if (Transactions.Num() == 0)
+	{
+		UE_LOG(LogData, Error, TEXT("No transaction to rollback"));
+		return;
+	}
+
+	Transactions.Pop()->Rollback();
+}
@@ -2,7 +2,9 @@
 
 #include "PsDataPlugin.h"
 
+#include "PsDataChangeDispatcher.h"
 #include "PsDataCore.h"
+#include "PsDataEventQueue.h"
 #include "PsDataHardObjectPtr.h"
 
 #include "Misc/CoreDelegates.h"
@@ -21,6 +23,8 @@ void FPsDataPluginModule::StartupModule()
 
 void FPsDataPluginModule::ShutdownModule()
 {
+	FPsDataChangeDispatcher::Get().Reset();
+	FPsDataEventQueue::Get().Reset();
 }
 
 #undef LOCTEXT_NAMESPACE
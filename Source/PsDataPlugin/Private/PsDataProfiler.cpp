@@ -0,0 +1,219 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "PsDataProfiler.h"
+
+#include "PsData.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+bool FPsDataProfiler::bEnabled = false;
+double FPsDataProfiler::StartTime = 0.0;
+double FPsDataProfiler::StopTime = 0.0;
+TMap<TWeakObjectPtr<UClass>, FPsDataProfiler::FClassCounters> FPsDataProfiler::Counters;
+
+SIZE_T FPsDataMemoryUsage::GetTotal() const
+{
+	return Object + Properties + Delegates + Children + Keys + Hash;
+}
+
+void FPsDataProfiler::Start()
+{
+	Counters.Reset();
+	StartTime = FPlatformTime::Seconds();
+	StopTime = StartTime;
+	bEnabled = true;
+}
+
+void FPsDataProfiler::Stop()
+{
+	if (bEnabled)
+	{
+		StopTime = FPlatformTime::Seconds();
+		bEnabled = false;
+	}
+}
+
+bool FPsDataProfiler::IsEnabled()
+{
+	return bEnabled;
+}
+
+void FPsDataProfiler::CountInternal(const UPsData* Data, EPsDataProfilerCounter Counter)
+{
+	++Counters.FindOrAdd(Data->GetClass()).Values[static_cast<int32>(Counter)];
+}
+
+/** Write CSV and log result */
+static void SaveCsv(const FString& CsvPath, const FString& Csv)
+{
+	if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		UE_LOG(LogData, Display, TEXT("Saved %s"), *CsvPath);
+	}
+	else
+	{
+		UE_LOG(LogData, Error, TEXT("Can't save %s"), *CsvPath);
+	}
+}
+
+void FPsDataProfiler::ReportStats(const FString& CsvPath)
+{
+	if (StartTime == 0.0)
+	{
+		UE_LOG(LogData, Display, TEXT("PsData stats are not collected, run \"PsData.Stats Start\" first"));
+		return;
+	}
+
+	const double Seconds = FMath::Max((bEnabled ? FPlatformTime::Seconds() : StopTime) - StartTime, 0.001);
+
+	struct FRow
+	{
+		FString Class;
+		double Rates[static_cast<int32>(EPsDataProfilerCounter::Num)];
+		double Total;
+	};
+
+	TArray<FRow> Rows;
+	for (const auto& Pair : Counters)
+	{
+		const UClass* Class = Pair.Key.Get();
+
+		FRow Row;
+		Row.Class = Class ? Class->GetName() : TEXT("<unloaded>");
+		Row.Total = 0.0;
+		for (int32 i = 0; i < static_cast<int32>(EPsDataProfilerCounter::Num); ++i)
+		{
+			Row.Rates[i] = Pair.Value.Values[i] / Seconds;
+			Row.Total += Row.Rates[i];
+		}
+		Rows.Add(Row);
+	}
+
+	Rows.Sort([](const FRow& A, const FRow& B) { return A.Total > B.Total; });
+
+	UE_LOG(LogData, Display, TEXT("PsData stats for %.1f s, per second:"), Seconds);
+	UE_LOG(LogData, Display, TEXT("%-48s %12s %12s %12s"), TEXT("Class"), TEXT("Sets"), TEXT("Broadcasts"), TEXT("Hashes"));
+
+	FString Csv = TEXT("Class,SetsPerSecond,BroadcastsPerSecond,HashesPerSecond\n");
+	for (const FRow& Row : Rows)
+	{
+		UE_LOG(LogData, Display, TEXT("%-48s %12.1f %12.1f %12.1f"), *Row.Class, Row.Rates[0], Row.Rates[1], Row.Rates[2]);
+		Csv += FString::Printf(TEXT("%s,%.3f,%.3f,%.3f\n"), *Row.Class, Row.Rates[0], Row.Rates[1], Row.Rates[2]);
+	}
+
+	if (!CsvPath.IsEmpty())
+	{
+		SaveCsv(CsvPath, Csv);
+	}
+}
+
+void FPsDataProfiler::ReportMemory(const FString& CsvPath)
+{
+	struct FRow
+	{
+		FString Class;
+		int32 Count = 0;
+		FPsDataMemoryUsage Usage;
+	};
+
+	TMap<const UClass*, FRow> RowsByClass;
+	for (TObjectIterator<UPsData> It; It; ++It)
+	{
+		const UPsData* Data = *It;
+		if (Data->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			continue;
+		}
+
+		FRow& Row = RowsByClass.FindOrAdd(Data->GetClass());
+		++Row.Count;
+		FDataReflectionTools::FPsDataFriend::CountMemory(Data, Row.Usage);
+	}
+
+	TArray<FRow> Rows;
+	FRow Total;
+	Total.Class = TEXT("Total");
+	for (auto& Pair : RowsByClass)
+	{
+		Pair.Value.Class = Pair.Key->GetName();
+		Total.Count += Pair.Value.Count;
+		Total.Usage.Object += Pair.Value.Usage.Object;
+		Total.Usage.Properties += Pair.Value.Usage.Properties;
+		Total.Usage.Delegates += Pair.Value.Usage.Delegates;
+		Total.Usage.Children += Pair.Value.Usage.Children;
+		Total.Usage.Keys += Pair.Value.Usage.Keys;
+		Total.Usage.Hash += Pair.Value.Usage.Hash;
+		Rows.Add(Pair.Value);
+	}
+
+	Rows.Sort([](const FRow& A, const FRow& B) { return A.Usage.GetTotal() > B.Usage.GetTotal(); });
+	Rows.Add(Total);
+
+	UE_LOG(LogData, Display, TEXT("PsData memory, bytes:"));
+	UE_LOG(LogData, Display, TEXT("%-48s %8s %10s %10s %10s %10s %10s %10s %12s"), TEXT("Class"), TEXT("Count"), TEXT("Object"), TEXT("Properties"), TEXT("Delegates"), TEXT("Children"), TEXT("Keys"), TEXT("Hash"), TEXT("Total"));
+
+	FString Csv = TEXT("Class,Count,Object,Properties,Delegates,Children,Keys,Hash,Total\n");
+	for (const FRow& Row : Rows)
+	{
+		const FPsDataMemoryUsage& U = Row.Usage;
+		UE_LOG(LogData, Display, TEXT("%-48s %8d %10llu %10llu %10llu %10llu %10llu %10llu %12llu"), *Row.Class, Row.Count, (uint64)U.Object, (uint64)U.Properties, (uint64)U.Delegates, (uint64)U.Children, (uint64)U.Keys, (uint64)U.Hash, (uint64)U.GetTotal());
+		Csv += FString::Printf(TEXT("%s,%d,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n"), *Row.Class, Row.Count, (uint64)U.Object, (uint64)U.Properties, (uint64)U.Delegates, (uint64)U.Children, (uint64)U.Keys, (uint64)U.Hash, (uint64)U.GetTotal());
+	}
+
+	if (!CsvPath.IsEmpty())
+	{
+		SaveCsv(CsvPath, Csv);
+	}
+}
+
+/***********************************
+ * Console commands
+ ***********************************/
+
+/** Csv=<path> or Csv for file in profiling directory, empty if not requested */
+static FString GetCsvPath(const TArray<FString>& Args, const TCHAR* Name)
+{
+	for (const FString& Arg : Args)
+	{
+		if (Arg.StartsWith(TEXT("Csv=")))
+		{
+			return Arg.RightChop(4);
+		}
+
+		if (Arg.Equals(TEXT("Csv"), ESearchCase::IgnoreCase))
+		{
+			return FPaths::ProfilingDir() / TEXT("PsData") / FString::Printf(TEXT("%s-%s.csv"), Name, *FDateTime::Now().ToString());
+		}
+	}
+
+	return FString();
+}
+
+static FAutoConsoleCommand PsDataStatsCommand(
+	TEXT("PsData.Stats"),
+	TEXT("Sets, broadcasts and hash calculations per second by data class. Args: Start, Stop, Csv or Csv=<path>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		if (Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("Start"), ESearchCase::IgnoreCase); }))
+		{
+			FPsDataProfiler::Start();
+			UE_LOG(LogData, Display, TEXT("PsData stats started"));
+			return;
+		}
+
+		if (Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("Stop"), ESearchCase::IgnoreCase); }))
+		{
+			FPsDataProfiler::Stop();
+		}
+
+		FPsDataProfiler::ReportStats(GetCsvPath(Args, TEXT("Stats")));
+	}));
+
+static FAutoConsoleCommand PsDataMemoryCommand(
+	TEXT("PsData.Memory"),
+	TEXT("Instance count and memory usage by data class. Args: Csv or Csv=<path>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		FPsDataProfiler::ReportMemory(GetCsvPath(Args, TEXT("Memory")));
+	}));
@@ -2,7 +2,134 @@
 
 #include "PsDataRoot.h"
 
+#include "PsDataCore.h"
+#include "PsDataFunctionLibrary.h"
+
+int32 UPsDataRoot::NumLinkIndices = 0;
+
 UPsDataRoot::UPsDataRoot(const class FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, bLinkIndex(false)
+{
+}
+
+void UPsDataRoot::EnableLinkIndex()
+{
+	if (bLinkIndex)
+	{
+		return;
+	}
+
+	bLinkIndex = true;
+	++NumLinkIndices;
+	IndexLinks(this, true);
+}
+
+void UPsDataRoot::DisableLinkIndex()
+{
+	if (!bLinkIndex)
+	{
+		return;
+	}
+
+	bLinkIndex = false;
+	--NumLinkIndices;
+	LinkIndex.Empty();
+	LinkIndexEntries.Empty();
+}
+
+bool UPsDataRoot::IsLinkIndexEnabled() const
+{
+	return bLinkIndex;
+}
+
+TArray<UPsData*> UPsDataRoot::FindLinkedBy(const FString& LinkPath, const FString& Key) const
+{
+	if (!bLinkIndex)
+	{
+		UE_LOG(LogData, Warning, TEXT("Link index of \"%s\" is disabled"), *GetName());
+		return {};
+	}
+
+	if (const auto* KeyMap = LinkIndex.Find(LinkPath))
+	{
+		if (const auto* Set = KeyMap->Find(Key))
+		{
+			return Set->Array();
+		}
+	}
+
+	return {};
+}
+
+void UPsDataRoot::IndexLinks(UPsData* Data, bool bRecursive)
 {
-}
\ No newline at end of file
+	UnindexLinks(Data, false);
+
+	for (const auto& Pair : FDataReflection::GetLinks(Data->GetClass()))
+	{
+		const TSharedPtr<const FDataLink>& Link = Pair.Value;
+		if (Link->bAbstract)
+		{
+			continue;
+		}
+
+		TArray<FString> Keys;
+		UPsDataFunctionLibrary::GetLinkKeys(Data, Link, Keys);
+
+		const FString& LinkPath = UPsDataFunctionLibrary::GetLinkPath(Data, Link);
+		for (const FString& Key : Keys)
+		{
+			if (Key.Len() > 0)
+			{
+				LinkIndex.FindOrAdd(LinkPath).FindOrAdd(Key).Add(Data);
+				LinkIndexEntries.FindOrAdd(Data).Emplace(LinkPath, Key);
+			}
+		}
+	}
+
+	if (bRecursive)
+	{
+		for (UPsData* Child : FDataReflectionTools::FPsDataFriend::GetChildren(Data))
+		{
+			IndexLinks(Child, true);
+		}
+	}
+}
+
+void UPsDataRoot::UnindexLinks(UPsData* Data, bool bRecursive)
+{
+	TArray<TPair<FString, FString>> Entries;
+	if (LinkIndexEntries.RemoveAndCopyValue(Data, Entries))
+	{
+		for (const auto& Entry : Entries)
+		{
+			if (auto* KeyMap = LinkIndex.Find(Entry.Key))
+			{
+				if (auto* Set = KeyMap->Find(Entry.Value))
+				{
+					Set->Remove(Data);
+					if (Set->Num() == 0)
+					{
+						KeyMap->Remove(Entry.Value);
+					}
+				}
+			}
+		}
+	}
+
+	if (bRecursive)
+	{
+		for (UPsData* Child : FDataReflectionTools::FPsDataFriend::GetChildren(Data))
+		{
+			UnindexLinks(Child, true);
+		}
+	}
+}
+
+void UPsDataRoot::BeginDestroy()
+{
+	DisableLinkIndex();
+
+	Super::BeginDestroy();
+}
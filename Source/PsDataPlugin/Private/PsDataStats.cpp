@@ -0,0 +1,38 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "PsDataStats.h"
+
+#include "PsData.h"
+
+#include "Trace/Trace.inl"
+
+DEFINE_STAT(STAT_PsDataSerialize);
+DEFINE_STAT(STAT_PsDataDeserialize);
+DEFINE_STAT(STAT_PsDataSet);
+DEFINE_STAT(STAT_PsDataBroadcast);
+DEFINE_STAT(STAT_PsDataCalculateHash);
+DEFINE_STAT(STAT_PsDataResolveLink);
+DEFINE_STAT(STAT_PsDataGetByPath);
+
+UE_TRACE_CHANNEL_DEFINE(PsDataChannel)
+
+UE_TRACE_EVENT_BEGIN(PsData, Broadcast)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, CharSize)
+UE_TRACE_EVENT_END()
+
+void FPsDataTrace::Broadcast(const UPsData* Data, FName Type)
+{
+#if UE_TRACE_ENABLED
+	// Attachment is "Class:Type"
+	FString Name = Data->GetClass()->GetName();
+	Name.AppendChar(TEXT(':'));
+	Type.AppendString(Name);
+
+	const uint16 Size = (Name.Len() + 1) * sizeof(TCHAR);
+	UE_TRACE_LOG(PsData, Broadcast, PsDataChannel, Size)
+		<< Broadcast.Cycle(FPlatformTime::Cycles64())
+		<< Broadcast.CharSize(uint8(sizeof(TCHAR)))
+		<< Broadcast.Attachment(*Name, Size);
+#endif
+}
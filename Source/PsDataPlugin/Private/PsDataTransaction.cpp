@@ -0,0 +1,198 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "PsDataTransaction.h"
+
+#include "PsData.h"
+#include "PsDataField.h"
+
+FPsDataTransaction* FPsDataTransaction::Current = nullptr;
+
+FPsDataTransaction::FPsDataTransaction()
+	: Outer(Current)
+	, bFinished(false)
+	, bRestoring(false)
+{
+	check(IsInGameThread());
+	Current = this;
+}
+
+FPsDataTransaction::~FPsDataTransaction()
+{
+	if (!bFinished)
+	{
+		Commit();
+	}
+}
+
+void FPsDataTransaction::Commit()
+{
+	if (bFinished)
+	{
+		UE_LOG(LogData, Error, TEXT("Transaction already finished"));
+		return;
+	}
+
+	Finish(true);
+}
+
+void FPsDataTransaction::Rollback()
+{
+	if (bFinished)
+	{
+		UE_LOG(LogData, Error, TEXT("Transaction already finished"));
+		return;
+	}
+
+	bRestoring = true;
+	for (int32 i = Records.Num() - 1; i >= 0; --i)
+	{
+		UPsData* Data = Records[i].Data.Get();
+		if (Data)
+		{
+			Records[i].Restore(Data);
+		}
+	}
+	bRestoring = false;
+
+	Records.Empty();
+	RecordedProperties.Empty();
+	ElementChanges.Empty();
+
+	// Restored values aren't changes for outer transaction, only hashes calculated meanwhile are dropped
+	if (Outer)
+	{
+		Flush(false);
+		Changes.Empty();
+		ChangedFields.Empty();
+	}
+
+	Finish(false);
+}
+
+bool FPsDataTransaction::IsFinished() const
+{
+	return bFinished;
+}
+
+FPsDataTransaction* FPsDataTransaction::GetCurrent()
+{
+	return Current;
+}
+
+void FPsDataTransaction::Record(UPsData* Data, FAbstractDataProperty* Property)
+{
+	if (bRestoring)
+	{
+		return;
+	}
+
+	bool bAlreadyRecorded = false;
+	RecordedProperties.Add(Property, &bAlreadyRecorded);
+	if (bAlreadyRecorded)
+	{
+		return;
+	}
+
+	TFunction<void(UPsData*)> Restore = Property->Snapshot();
+	if (Restore)
+	{
+		Records.Add({Data, Property, MoveTemp(Restore)});
+	}
+}
+
+void FPsDataTransaction::Changed(UPsData* Data, const TSharedPtr<const FDataField>& Field)
+{
+	bool bAlreadyChanged = false;
+	ChangedFields.Add(TPair<const UPsData*, const FDataField*>(Data, Field.Get()), &bAlreadyChanged);
+	if (!bAlreadyChanged)
+	{
+		Changes.Add({Data, Field});
+	}
+}
+
+void FPsDataTransaction::ChangedElement(UPsData* Data, const TSharedPtr<const FDataField>& Field, FName Type, int32 Index)
+{
+	if (!bRestoring)
+	{
+		ElementChanges.Add({Data, Field, Type, Index});
+	}
+}
+
+void FPsDataTransaction::Finish(bool bBroadcast)
+{
+	check(Current == this);
+
+	bFinished = true;
+	Current = Outer;
+
+	if (!Outer)
+	{
+		Flush(bBroadcast);
+		return;
+	}
+
+	for (FRecord& Record : Records)
+	{
+		bool bAlreadyRecorded = false;
+		Outer->RecordedProperties.Add(Record.Property, &bAlreadyRecorded);
+		if (!bAlreadyRecorded)
+		{
+			Outer->Records.Add(MoveTemp(Record));
+		}
+	}
+
+	for (const FChange& Change : Changes)
+	{
+		if (UPsData* Data = Change.Data.Get())
+		{
+			Outer->Changed(Data, Change.Field);
+		}
+	}
+
+	Outer->ElementChanges.Append(MoveTemp(ElementChanges));
+}
+
+void FPsDataTransaction::Flush(bool bBroadcast)
+{
+	TSet<UPsData*> Dropped;
+	for (const FChange& Change : Changes)
+	{
+		if (UPsData* Data = Change.Data.Get())
+		{
+			FDataReflectionTools::FPsDataFriend::DropHash(Data, Dropped);
+		}
+	}
+
+	if (!bBroadcast)
+	{
+		return;
+	}
+
+	for (const FElementChange& Change : ElementChanges)
+	{
+		if (UPsData* Data = Change.Data.Get())
+		{
+			FDataReflectionTools::FPsDataFriend::BroadcastElement(Data, Change.Field, Change.Type, Change.Index);
+		}
+	}
+
+	TSet<TPair<const UPsData*, FName>> Broadcasted;
+	TMap<FName, TSet<TPair<const UPsData*, const FDataField*>>> Bubbled;
+	for (const FChange& Change : Changes)
+	{
+		UPsData* Data = Change.Data.Get();
+		if (!Data)
+		{
+			continue;
+		}
+
+		const FName Type = Change.Field->GetChangedEventId();
+
+		bool bAlreadyBroadcasted = false;
+		Broadcasted.Add(TPair<const UPsData*, FName>(Data, Type), &bAlreadyBroadcasted);
+		if (!bAlreadyBroadcasted)
+		{
+			FDataReflectionTools::FPsDataFriend::BroadcastChanged(Data, Change.Field, &Bubbled.FindOrAdd(Type));
+		}
+	}
+}
@@ -3,13 +3,15 @@
 #include "Serialize/PsDataBinarySerialization.h"
 
 #include "PsData.h"
+#include "Serialize/Stream/PsDataBufferOutputStream.h"
 
 /***********************************
  * FBinaryDataSerializer
  ***********************************/
 
 FPsDataBinarySerializer::FPsDataBinarySerializer(TSharedRef<FPsDataOutputStream> InOutputStream)
-	: OutputStream(InOutputStream)
+	: FPsDataSerializer(EPsDataSerializerType::Binary)
+	, OutputStream(InOutputStream)
 {
 }
 
@@ -18,12 +20,25 @@ TSharedRef<FPsDataOutputStream> FPsDataBinarySerializer::GetOutputStream() const
 	return OutputStream;
 }
 
+TArray<uint8> FPsDataBinarySerializer::EncodeKey(const FString& Key)
+{
+	FPsDataBufferOutputStream Stream;
+	Stream.WriteUint8(static_cast<uint8>(EBinaryTokens::Key));
+	Stream.WriteString(Key);
+	return Stream.GetBuffer();
+}
+
 void FPsDataBinarySerializer::WriteKey(const FString& Key)
 {
 	OutputStream->WriteUint8(static_cast<uint8>(EBinaryTokens::Key));
 	OutputStream->WriteString(Key);
 }
 
+void FPsDataBinarySerializer::WriteFieldKey(const FPsDataClassPlanEntry& Entry)
+{
+	OutputStream->WriteBuffer(Entry.BinaryKey);
+}
+
 void FPsDataBinarySerializer::WriteArray()
 {
 	OutputStream->WriteUint8(static_cast<uint8>(EBinaryTokens::ArrayBegin));
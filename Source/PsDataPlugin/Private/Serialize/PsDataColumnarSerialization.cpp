@@ -0,0 +1,625 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "Serialize/PsDataColumnarSerialization.h"
+
+#include "PsData.h"
+#include "PsDataCore.h"
+#include "Serialize/PsDataBinarySerialization.h"
+#include "Serialize/Stream/PsDataBufferInputStream.h"
+#include "Serialize/Stream/PsDataBufferOutputStream.h"
+#include "Types/PsData_FName.h"
+#include "Types/PsData_FString.h"
+#include "Types/PsData_UPsData.h"
+#include "Types/PsData_bool.h"
+#include "Types/PsData_float.h"
+#include "Types/PsData_int32.h"
+#include "Types/PsData_int64.h"
+#include "Types/PsData_uint8.h"
+
+/***********************************
+ * Utils
+ ***********************************/
+
+namespace PsDataColumnar
+{
+static constexpr uint32 Version = 1;
+
+EPsDataColumnType GetColumnType(const FDataField& Field)
+{
+	const FAbstractDataTypeContext* Context = Field.Context;
+	if (Context->IsContainer())
+	{
+		return EPsDataColumnType::Binary;
+	}
+
+	if (Context->IsEnum())
+	{
+		return EPsDataColumnType::Uint8;
+	}
+
+	const uint32 Hash = Context->GetHash();
+	if (Hash == FDataReflectionTools::FType<int32>::Hash())
+	{
+		return EPsDataColumnType::Int32;
+	}
+	else if (Hash == FDataReflectionTools::FType<int64>::Hash())
+	{
+		return EPsDataColumnType::Int64;
+	}
+	else if (Hash == FDataReflectionTools::FType<float>::Hash())
+	{
+		return EPsDataColumnType::Float;
+	}
+	else if (Hash == FDataReflectionTools::FType<bool>::Hash())
+	{
+		return EPsDataColumnType::Bool;
+	}
+	else if (Hash == FDataReflectionTools::FType<uint8>::Hash())
+	{
+		return EPsDataColumnType::Uint8;
+	}
+	else if (Hash == FDataReflectionTools::FType<FString>::Hash())
+	{
+		return EPsDataColumnType::String;
+	}
+	else if (Hash == FDataReflectionTools::FType<FName>::Hash())
+	{
+		return EPsDataColumnType::Name;
+	}
+
+	return EPsDataColumnType::Binary;
+}
+
+template <typename T>
+const T& GetValue(UPsData* Row, const TSharedPtr<const FDataField>& Field)
+{
+	T* ValuePtr = nullptr;
+	FDataReflectionTools::UnsafeGet<T>(Row, Field, ValuePtr);
+	return *ValuePtr;
+}
+
+template <typename T>
+void WriteArray(FPsDataOutputStream& OutputStream, const TArray<T>& Values, void (FPsDataOutputStream::*Write)(T))
+{
+	OutputStream.WriteInt32(Values.Num());
+	for (const T& Value : Values)
+	{
+		(OutputStream.*Write)(Value);
+	}
+}
+
+/** Read array of values taking ElementSize bytes each, count is checked against the rest of stream before allocation */
+template <typename T>
+bool ReadArray(FPsDataInputStream& InputStream, TArray<T>& OutValues, T (FPsDataInputStream::*Read)(), int32 ElementSize)
+{
+	const int32 Num = InputStream.ReadInt32();
+	if (Num < 0 || static_cast<int64>(Num) * ElementSize > InputStream.Remaining())
+	{
+		return false;
+	}
+
+	OutValues.Reset(Num);
+	for (int32 i = 0; i < Num; ++i)
+	{
+		OutValues.Add((InputStream.*Read)());
+	}
+	return true;
+}
+
+/** Offsets start at zero, don't decrease and stay within values of size */
+bool IsValidOffsets(const TArray<int32>& Offsets, int32 Size)
+{
+	if (Offsets.Num() == 0)
+	{
+		return Size == 0;
+	}
+
+	if (Offsets[0] != 0)
+	{
+		return false;
+	}
+
+	for (int32 i = 1; i < Offsets.Num(); ++i)
+	{
+		if (Offsets[i] < Offsets[i - 1])
+		{
+			return false;
+		}
+	}
+
+	return Offsets.Last() <= Size;
+}
+
+/** Offsets of string and binary column are valid */
+bool IsValidColumn(const FPsDataColumn& Column)
+{
+	switch (Column.Type)
+	{
+	case EPsDataColumnType::String:
+	case EPsDataColumnType::Name:
+		return IsValidOffsets(Column.Offsets, Column.Chars.Num());
+	case EPsDataColumnType::Binary:
+		return IsValidOffsets(Column.Offsets, Column.Bytes.Num());
+	default:
+		return true;
+	}
+}
+
+void WriteColumn(FPsDataOutputStream& OutputStream, const FPsDataColumn& Column)
+{
+	OutputStream.WriteString(Column.Alias);
+	OutputStream.WriteUint32(Column.TypeHash);
+	OutputStream.WriteUint8(static_cast<uint8>(Column.Type));
+
+	switch (Column.Type)
+	{
+	case EPsDataColumnType::Int32:
+		WriteArray(OutputStream, Column.Int32Values, &FPsDataOutputStream::WriteInt32);
+		break;
+	case EPsDataColumnType::Int64:
+		WriteArray(OutputStream, Column.Int64Values, &FPsDataOutputStream::WriteInt64);
+		break;
+	case EPsDataColumnType::Float:
+		WriteArray(OutputStream, Column.FloatValues, &FPsDataOutputStream::WriteFloat);
+		break;
+	case EPsDataColumnType::Bool:
+	case EPsDataColumnType::Uint8:
+		OutputStream.WriteInt32(Column.ByteValues.Num());
+		OutputStream.WriteBuffer(Column.ByteValues);
+		break;
+	case EPsDataColumnType::String:
+	case EPsDataColumnType::Name:
+		WriteArray(OutputStream, Column.Offsets, &FPsDataOutputStream::WriteInt32);
+		WriteArray(OutputStream, Column.Chars, &FPsDataOutputStream::WriteTCHAR);
+		break;
+	case EPsDataColumnType::Binary:
+		WriteArray(OutputStream, Column.Offsets, &FPsDataOutputStream::WriteInt32);
+		OutputStream.WriteInt32(Column.Bytes.Num());
+		OutputStream.WriteBuffer(Column.Bytes);
+		break;
+	}
+}
+
+bool ReadColumn(FPsDataInputStream& InputStream, FPsDataColumn& OutColumn)
+{
+	OutColumn.Alias = InputStream.ReadString();
+	OutColumn.TypeHash = InputStream.ReadUint32();
+	OutColumn.Type = static_cast<EPsDataColumnType>(InputStream.ReadUint8());
+
+	switch (OutColumn.Type)
+	{
+	case EPsDataColumnType::Int32:
+		return ReadArray(InputStream, OutColumn.Int32Values, &FPsDataInputStream::ReadInt32, 4);
+	case EPsDataColumnType::Int64:
+		return ReadArray(InputStream, OutColumn.Int64Values, &FPsDataInputStream::ReadInt64, 8);
+	case EPsDataColumnType::Float:
+		return ReadArray(InputStream, OutColumn.FloatValues, &FPsDataInputStream::ReadFloat, 4);
+	case EPsDataColumnType::Bool:
+	case EPsDataColumnType::Uint8:
+		return ReadArray(InputStream, OutColumn.ByteValues, &FPsDataInputStream::ReadUint8, 1);
+	case EPsDataColumnType::String:
+	case EPsDataColumnType::Name:
+		return ReadArray(InputStream, OutColumn.Offsets, &FPsDataInputStream::ReadInt32, 4) && ReadArray(InputStream, OutColumn.Chars, &FPsDataInputStream::ReadTCHAR, 4) && IsValidColumn(OutColumn);
+	case EPsDataColumnType::Binary:
+		return ReadArray(InputStream, OutColumn.Offsets, &FPsDataInputStream::ReadInt32, 4) && ReadArray(InputStream, OutColumn.Bytes, &FPsDataInputStream::ReadUint8, 1) && IsValidColumn(OutColumn);
+	default:
+		return false;
+	}
+}
+
+const TSharedPtr<const FDataField>& FindCollectionField(UPsData* Instance, int32 FieldHash)
+{
+	const auto& Field = FDataReflection::GetFieldByHash(Instance->GetClass(), FieldHash);
+	if (!Field.IsValid())
+	{
+		UE_LOG(LogData, Error, TEXT("Can't find property %d in \"%s\""), FieldHash, *Instance->GetClass()->GetName());
+	}
+	else if (!Field->Context->IsMap() || !Field->Context->IsData())
+	{
+		UE_LOG(LogData, Error, TEXT("Property \"%s::%s\" is not map of data"), *Instance->GetClass()->GetName(), *Field->Name);
+		static const TSharedPtr<const FDataField> EmptySharedPtr(nullptr);
+		return EmptySharedPtr;
+	}
+	return Field;
+}
+} // namespace PsDataColumnar
+
+/***********************************
+ * FPsDataColumn
+ ***********************************/
+
+FPsDataColumn::FPsDataColumn()
+	: TypeHash(0)
+	, Type(EPsDataColumnType::Binary)
+{
+}
+
+FPsDataColumn::FPsDataColumn(const FString& InAlias, uint32 InTypeHash, EPsDataColumnType InType)
+	: Alias(InAlias)
+	, TypeHash(InTypeHash)
+	, Type(InType)
+{
+}
+
+int32 FPsDataColumn::Num() const
+{
+	switch (Type)
+	{
+	case EPsDataColumnType::Int32:
+		return Int32Values.Num();
+	case EPsDataColumnType::Int64:
+		return Int64Values.Num();
+	case EPsDataColumnType::Float:
+		return FloatValues.Num();
+	case EPsDataColumnType::Bool:
+	case EPsDataColumnType::Uint8:
+		return ByteValues.Num();
+	default:
+		return FMath::Max(Offsets.Num() - 1, 0);
+	}
+}
+
+void FPsDataColumn::AddString(const FString& Value)
+{
+	if (Offsets.Num() == 0)
+	{
+		Offsets.Add(0);
+	}
+
+	Chars.Append(Value.GetCharArray().GetData(), Value.Len());
+	Offsets.Add(Chars.Num());
+}
+
+FString FPsDataColumn::GetString(int32 Row) const
+{
+	check(Offsets.IsValidIndex(Row + 1));
+	const int32 Start = Offsets[Row];
+	return FString(Offsets[Row + 1] - Start, Chars.GetData() + Start);
+}
+
+void FPsDataColumn::AddBytes(const TArray<uint8>& Value)
+{
+	if (Offsets.Num() == 0)
+	{
+		Offsets.Add(0);
+	}
+
+	Bytes.Append(Value);
+	Offsets.Add(Bytes.Num());
+}
+
+TArray<uint8> FPsDataColumn::GetBytes(int32 Row) const
+{
+	check(Offsets.IsValidIndex(Row + 1));
+	const int32 Start = Offsets[Row];
+	return TArray<uint8>(Bytes.GetData() + Start, Offsets[Row + 1] - Start);
+}
+
+/***********************************
+ * FPsDataColumnarTable
+ ***********************************/
+
+FPsDataColumnarTable::FPsDataColumnarTable()
+	: Class(nullptr)
+	, Keys(TEXT(""), 0, EPsDataColumnType::String)
+{
+}
+
+int32 FPsDataColumnarTable::Num() const
+{
+	return Keys.Num();
+}
+
+const FPsDataColumn* FPsDataColumnarTable::FindColumn(const FString& Alias) const
+{
+	return Columns.FindByPredicate([&Alias](const FPsDataColumn& Column) {
+		return Column.Alias == Alias;
+	});
+}
+
+/***********************************
+ * FPsDataColumnarSerializer
+ ***********************************/
+
+bool FPsDataColumnarSerializer::Export(const TMap<FString, UPsData*>& Collection, UClass* Class, FPsDataColumnarTable& OutTable)
+{
+	check(Class);
+
+	for (const auto& Pair : Collection)
+	{
+		if (Pair.Value == nullptr || Pair.Value->GetClass() != Class)
+		{
+			UE_LOG(LogData, Error, TEXT("Can't export \"%s\" as column, collection must contain only \"%s\""), *Pair.Key, *Class->GetName());
+			return false;
+		}
+	}
+
+	OutTable = FPsDataColumnarTable();
+	OutTable.Class = Class;
+
+	const int32 NumRows = Collection.Num();
+	OutTable.Keys.Offsets.Reserve(NumRows + 1);
+	OutTable.Keys.Offsets.Add(0);
+	for (const auto& Pair : Collection)
+	{
+		OutTable.Keys.AddString(Pair.Key);
+	}
+
+	for (const auto& FieldPair : FDataReflection::GetAliasFields(Class))
+	{
+		const TSharedPtr<const FDataField>& Field = FieldPair.Value;
+		FPsDataColumn& Column = OutTable.Columns.Emplace_GetRef(FieldPair.Key, Field->Context->GetHash(), PsDataColumnar::GetColumnType(*Field));
+
+		switch (Column.Type)
+		{
+		case EPsDataColumnType::Int32:
+			Column.Int32Values.Reserve(NumRows);
+			for (const auto& Pair : Collection)
+			{
+				Column.Int32Values.Add(PsDataColumnar::GetValue<int32>(Pair.Value, Field));
+			}
+			break;
+		case EPsDataColumnType::Int64:
+			Column.Int64Values.Reserve(NumRows);
+			for (const auto& Pair : Collection)
+			{
+				Column.Int64Values.Add(PsDataColumnar::GetValue<int64>(Pair.Value, Field));
+			}
+			break;
+		case EPsDataColumnType::Float:
+			Column.FloatValues.Reserve(NumRows);
+			for (const auto& Pair : Collection)
+			{
+				Column.FloatValues.Add(PsDataColumnar::GetValue<float>(Pair.Value, Field));
+			}
+			break;
+		case EPsDataColumnType::Bool:
+			Column.ByteValues.Reserve(NumRows);
+			for (const auto& Pair : Collection)
+			{
+				Column.ByteValues.Add(PsDataColumnar::GetValue<bool>(Pair.Value, Field) ? 1 : 0);
+			}
+			break;
+		case EPsDataColumnType::Uint8:
+			Column.ByteValues.Reserve(NumRows);
+			for (const auto& Pair : Collection)
+			{
+				Column.ByteValues.Add(PsDataColumnar::GetValue<uint8>(Pair.Value, Field));
+			}
+			break;
+		case EPsDataColumnType::String:
+			Column.Offsets.Reserve(NumRows + 1);
+			Column.Offsets.Add(0);
+			for (const auto& Pair : Collection)
+			{
+				Column.AddString(PsDataColumnar::GetValue<FString>(Pair.Value, Field));
+			}
+			break;
+		case EPsDataColumnType::Name:
+			Column.Offsets.Reserve(NumRows + 1);
+			Column.Offsets.Add(0);
+			for (const auto& Pair : Collection)
+			{
+				const FName& Name = PsDataColumnar::GetValue<FName>(Pair.Value, Field);
+				Column.AddString(Name == NAME_None ? FString() : Name.ToString());
+			}
+			break;
+		case EPsDataColumnType::Binary:
+		{
+			Column.Offsets.Reserve(NumRows + 1);
+			Column.Offsets.Add(0);
+			auto OutputStream = MakeShared<FPsDataBufferOutputStream>();
+			for (const auto& Pair : Collection)
+			{
+				OutputStream->Reset();
+				FPsDataBinarySerializer Serializer(OutputStream);
+				FDataReflectionTools::FPsDataFriend::GetProperties(Pair.Value)[Field->Index]->Serialize(Pair.Value, &Serializer);
+				Column.AddBytes(OutputStream->GetBuffer());
+			}
+			break;
+		}
+		}
+	}
+
+	return true;
+}
+
+bool FPsDataColumnarSerializer::Export(UPsData* Instance, int32 FieldHash, FPsDataColumnarTable& OutTable)
+{
+	const auto& Field = PsDataColumnar::FindCollectionField(Instance, FieldHash);
+	if (!Field.IsValid())
+	{
+		return false;
+	}
+
+	TMap<FString, UPsData*>* MapPtr = nullptr;
+	if (!FDataReflectionTools::GetByField(Instance, Field, MapPtr))
+	{
+		return false;
+	}
+
+	return Export(*MapPtr, CastChecked<UClass>(Field->Context->GetUE4Type()), OutTable);
+}
+
+bool FPsDataColumnarSerializer::Import(const FPsDataColumnarTable& Table, UPsData* Instance, int32 FieldHash)
+{
+	const auto& CollectionField = PsDataColumnar::FindCollectionField(Instance, FieldHash);
+	if (!CollectionField.IsValid())
+	{
+		return false;
+	}
+
+	UClass* Class = Table.Class ? Table.Class : CastChecked<UClass>(CollectionField->Context->GetUE4Type());
+	if (!Class->IsChildOf(CastChecked<UClass>(CollectionField->Context->GetUE4Type())))
+	{
+		UE_LOG(LogData, Error, TEXT("Can't import \"%s\" into \"%s::%s\""), *Class->GetName(), *Instance->GetClass()->GetName(), *CollectionField->Name);
+		return false;
+	}
+
+	if (Table.Keys.Type != EPsDataColumnType::String || !PsDataColumnar::IsValidColumn(Table.Keys))
+	{
+		UE_LOG(LogData, Error, TEXT("Keys column isn't string column with valid offsets"));
+		return false;
+	}
+
+	for (const FPsDataColumn& Column : Table.Columns)
+	{
+		if (!PsDataColumnar::IsValidColumn(Column))
+		{
+			UE_LOG(LogData, Error, TEXT("Column \"%s\" has invalid offsets"), *Column.Alias);
+			return false;
+		}
+	}
+
+	const int32 NumRows = Table.Num();
+	FPsDataAllocator Allocator(Class, Instance);
+	TArray<UPsData*> Rows;
+	Rows.Reserve(NumRows);
+	for (int32 i = 0; i < NumRows; ++i)
+	{
+		Rows.Add(Allocator());
+	}
+
+	for (const FPsDataColumn& Column : Table.Columns)
+	{
+		const TSharedPtr<const FDataField>& Field = FDataReflection::GetFieldByAlias(Class, Column.Alias);
+		if (!Field.IsValid())
+		{
+			UE_LOG(LogData, Warning, TEXT("Property \"%s\" not found in \"%s\""), *Column.Alias, *Class->GetName());
+			continue;
+		}
+
+		if (Column.Num() != NumRows)
+		{
+			UE_LOG(LogData, Error, TEXT("Column \"%s\" has %d rows, expected %d"), *Column.Alias, Column.Num(), NumRows);
+			return false;
+		}
+
+		if (Column.Type != PsDataColumnar::GetColumnType(*Field) || (Column.TypeHash != Field->Context->GetHash() && !Field->Context->IsEnum()))
+		{
+			UE_LOG(LogData, Warning, TEXT("Column \"%s\" type doesn't match \"%s::%s\""), *Column.Alias, *Class->GetName(), *Field->Name);
+			continue;
+		}
+
+		switch (Column.Type)
+		{
+		case EPsDataColumnType::Int32:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				FDataReflectionTools::UnsafeSet<int32>(Rows[i], Field, Column.Int32Values[i]);
+			}
+			break;
+		case EPsDataColumnType::Int64:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				FDataReflectionTools::UnsafeSet<int64>(Rows[i], Field, Column.Int64Values[i]);
+			}
+			break;
+		case EPsDataColumnType::Float:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				FDataReflectionTools::UnsafeSet<float>(Rows[i], Field, Column.FloatValues[i]);
+			}
+			break;
+		case EPsDataColumnType::Bool:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				FDataReflectionTools::UnsafeSet<bool>(Rows[i], Field, Column.ByteValues[i] != 0);
+			}
+			break;
+		case EPsDataColumnType::Uint8:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				FDataReflectionTools::UnsafeSet<uint8>(Rows[i], Field, Column.ByteValues[i]);
+			}
+			break;
+		case EPsDataColumnType::String:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				FDataReflectionTools::UnsafeSet<FString>(Rows[i], Field, Column.GetString(i));
+			}
+			break;
+		case EPsDataColumnType::Name:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				FDataReflectionTools::UnsafeSet<FName>(Rows[i], Field, FName(*Column.GetString(i)));
+			}
+			break;
+		case EPsDataColumnType::Binary:
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				const TArray<uint8> Bytes = Column.GetBytes(i);
+				FPsDataBinaryDeserializer Deserializer(MakeShared<FPsDataBufferInputStream>(Bytes));
+				FDataReflectionTools::FPsDataFriend::GetProperties(Rows[i])[Field->Index]->Deserialize(Rows[i], &Deserializer);
+			}
+			break;
+		}
+	}
+
+	TMap<FString, UPsData*> Collection;
+	Collection.Reserve(NumRows);
+	for (int32 i = 0; i < NumRows; ++i)
+	{
+		Collection.Add(Table.Keys.GetString(i), Rows[i]);
+	}
+
+	FDataReflectionTools::SetByField<TMap<FString, UPsData*>>(Instance, CollectionField, Collection);
+	return true;
+}
+
+void FPsDataColumnarSerializer::Write(const FPsDataColumnarTable& Table, TSharedRef<FPsDataOutputStream> OutputStream)
+{
+	OutputStream->WriteUint32(PsDataColumnar::Version);
+	OutputStream->WriteString(Table.Class ? Table.Class->GetPathName() : FString());
+	PsDataColumnar::WriteColumn(*OutputStream, Table.Keys);
+	OutputStream->WriteInt32(Table.Columns.Num());
+	for (const FPsDataColumn& Column : Table.Columns)
+	{
+		PsDataColumnar::WriteColumn(*OutputStream, Column);
+	}
+}
+
+bool FPsDataColumnarSerializer::Read(TSharedRef<FPsDataInputStream> InputStream, FPsDataColumnarTable& OutTable)
+{
+	OutTable = FPsDataColumnarTable();
+
+	const uint32 Version = InputStream->ReadUint32();
+	if (Version != PsDataColumnar::Version)
+	{
+		UE_LOG(LogData, Error, TEXT("Unsupported columnar version %d"), Version);
+		return false;
+	}
+
+	const FString ClassPath = InputStream->ReadString();
+	if (!ClassPath.IsEmpty())
+	{
+		OutTable.Class = FindObject<UClass>(nullptr, *ClassPath);
+		if (OutTable.Class == nullptr)
+		{
+			UE_LOG(LogData, Error, TEXT("Can't find class \"%s\""), *ClassPath);
+			return false;
+		}
+	}
+
+	if (!PsDataColumnar::ReadColumn(*InputStream, OutTable.Keys))
+	{
+		return false;
+	}
+
+	const int32 NumColumns = InputStream->ReadInt32();
+	if (NumColumns < 0)
+	{
+		return false;
+	}
+
+	OutTable.Columns.SetNum(NumColumns);
+	for (FPsDataColumn& Column : OutTable.Columns)
+	{
+		if (!PsDataColumnar::ReadColumn(*InputStream, Column))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -213,7 +213,8 @@ FString JsonStringToString(const TCHAR* String, int32 StartPosition, int32 Count
  ***********************************/
 
 FPsDataFastJsonSerializer::FPsDataFastJsonSerializer(bool bInPretty)
-	: bPretty(bInPretty)
+	: FPsDataSerializer(EPsDataSerializerType::FastJson)
+	, bPretty(bInPretty)
 	, Depth(0)
 {
 }
@@ -255,6 +256,24 @@ void FPsDataFastJsonSerializer::AppendValueSpace()
 	}
 }
 
+FString FPsDataFastJsonSerializer::EncodeKey(const FString& Key)
+{
+	FString Result;
+	Result.AppendChar('"');
+	Result.Append(StringToJsonString(Key.GetCharArray().GetData(), 0, Key.Len()));
+	Result.AppendChar('"');
+	Result.AppendChar(':');
+	return Result;
+}
+
+void FPsDataFastJsonSerializer::WriteFieldKey(const FPsDataClassPlanEntry& Entry)
+{
+	AppendComma();
+	AppendSpace();
+
+	JsonString.Append(Entry.JsonKey);
+}
+
 void FPsDataFastJsonSerializer::WriteKey(const FString& Key)
 {
 	AppendComma();
@@ -0,0 +1,860 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "Serialize/PsDataMsgPackSerialization.h"
+
+#include "PsData.h"
+
+/***********************************
+ * MessagePack format
+ ***********************************/
+
+namespace PsDataMsgPack
+{
+static constexpr uint8 Nil = 0xc0;
+static constexpr uint8 False = 0xc2;
+static constexpr uint8 True = 0xc3;
+static constexpr uint8 Bin8 = 0xc4;
+static constexpr uint8 Bin16 = 0xc5;
+static constexpr uint8 Bin32 = 0xc6;
+static constexpr uint8 Ext8 = 0xc7;
+static constexpr uint8 Ext16 = 0xc8;
+static constexpr uint8 Ext32 = 0xc9;
+static constexpr uint8 Float32 = 0xca;
+static constexpr uint8 Float64 = 0xcb;
+static constexpr uint8 Uint8 = 0xcc;
+static constexpr uint8 Uint16 = 0xcd;
+static constexpr uint8 Uint32 = 0xce;
+static constexpr uint8 Uint64 = 0xcf;
+static constexpr uint8 Int8 = 0xd0;
+static constexpr uint8 Int16 = 0xd1;
+static constexpr uint8 Int32 = 0xd2;
+static constexpr uint8 Int64 = 0xd3;
+static constexpr uint8 FixExt1 = 0xd4;
+static constexpr uint8 FixExt16 = 0xd8;
+static constexpr uint8 Str8 = 0xd9;
+static constexpr uint8 Str16 = 0xda;
+static constexpr uint8 Str32 = 0xdb;
+static constexpr uint8 Array16 = 0xdc;
+static constexpr uint8 Array32 = 0xdd;
+static constexpr uint8 Map16 = 0xde;
+static constexpr uint8 Map32 = 0xdf;
+static constexpr uint8 FixMap = 0x80;
+static constexpr uint8 FixArray = 0x90;
+static constexpr uint8 FixStr = 0xa0;
+static constexpr uint8 NegativeFixInt = 0xe0;
+} // namespace PsDataMsgPack
+
+/***********************************
+ * FPsDataMsgPackSerializer
+ ***********************************/
+
+FPsDataMsgPackSerializer::FPsDataMsgPackSerializer()
+	: FPsDataSerializer(EPsDataSerializerType::MsgPack)
+{
+}
+
+void FPsDataMsgPackSerializer::AddElement()
+{
+	if (Stack.Num() > 0 && !Stack.Last().bMap)
+	{
+		++Stack.Last().Count;
+	}
+}
+
+void FPsDataMsgPackSerializer::WriteContainer(bool bMap)
+{
+	AddElement();
+
+	// Size is unknown until pop, so the widest header is reserved and unused bytes are removed later
+	Stack.Add({Buffer.Num(), 0, bMap});
+	Buffer.AddZeroed(5);
+}
+
+void FPsDataMsgPackSerializer::PopContainer(bool bMap)
+{
+	check(Stack.Num() > 0 && Stack.Last().bMap == bMap);
+	const FContainer Container = Stack.Pop(false);
+	const uint32 Count = static_cast<uint32>(Container.Count);
+
+	uint8* Header = Buffer.GetData() + Container.Offset;
+	int32 HeaderSize = 0;
+	if (Count < 16)
+	{
+		Header[0] = (bMap ? PsDataMsgPack::FixMap : PsDataMsgPack::FixArray) | static_cast<uint8>(Count);
+		HeaderSize = 1;
+	}
+	else if (Count <= 0xffff)
+	{
+		Header[0] = bMap ? PsDataMsgPack::Map16 : PsDataMsgPack::Array16;
+		Header[1] = static_cast<uint8>(Count >> 8);
+		Header[2] = static_cast<uint8>(Count);
+		HeaderSize = 3;
+	}
+	else
+	{
+		Header[0] = bMap ? PsDataMsgPack::Map32 : PsDataMsgPack::Array32;
+		Header[1] = static_cast<uint8>(Count >> 24);
+		Header[2] = static_cast<uint8>(Count >> 16);
+		Header[3] = static_cast<uint8>(Count >> 8);
+		Header[4] = static_cast<uint8>(Count);
+		HeaderSize = 5;
+	}
+
+	if (HeaderSize < 5)
+	{
+		Gaps.Emplace(Container.Offset + HeaderSize, 5 - HeaderSize);
+	}
+
+	if (Stack.Num() == 0)
+	{
+		RemoveGaps();
+	}
+}
+
+void FPsDataMsgPackSerializer::RemoveGaps()
+{
+	if (Gaps.Num() == 0)
+	{
+		return;
+	}
+
+	// Containers are closed from inner to outer, so gaps are sorted by offset first
+	Gaps.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) {
+		return A.Key < B.Key;
+	});
+
+	uint8* Data = Buffer.GetData();
+	int32 WritePosition = Gaps[0].Key;
+	for (int32 i = 0; i < Gaps.Num(); ++i)
+	{
+		const int32 ReadPosition = Gaps[i].Key + Gaps[i].Value;
+		const int32 End = i + 1 < Gaps.Num() ? Gaps[i + 1].Key : Buffer.Num();
+		FMemory::Memmove(Data + WritePosition, Data + ReadPosition, End - ReadPosition);
+		WritePosition += End - ReadPosition;
+	}
+
+	Buffer.SetNum(WritePosition, false);
+	Gaps.Reset();
+}
+
+void FPsDataMsgPackSerializer::WriteBigEndian(uint64 Value, int32 NumBytes)
+{
+	for (int32 i = NumBytes - 1; i >= 0; --i)
+	{
+		Buffer.Add(static_cast<uint8>(Value >> (i * 8)));
+	}
+}
+
+void FPsDataMsgPackSerializer::WriteInteger(int64 Value)
+{
+	if (Value >= 0)
+	{
+		if (Value < 0x80)
+		{
+			Buffer.Add(static_cast<uint8>(Value));
+		}
+		else if (Value <= MAX_uint8)
+		{
+			Buffer.Add(PsDataMsgPack::Uint8);
+			WriteBigEndian(Value, 1);
+		}
+		else if (Value <= MAX_uint16)
+		{
+			Buffer.Add(PsDataMsgPack::Uint16);
+			WriteBigEndian(Value, 2);
+		}
+		else if (Value <= MAX_uint32)
+		{
+			Buffer.Add(PsDataMsgPack::Uint32);
+			WriteBigEndian(Value, 4);
+		}
+		else
+		{
+			Buffer.Add(PsDataMsgPack::Uint64);
+			WriteBigEndian(Value, 8);
+		}
+	}
+	else
+	{
+		if (Value >= -32)
+		{
+			Buffer.Add(static_cast<uint8>(static_cast<int8>(Value)));
+		}
+		else if (Value >= MIN_int8)
+		{
+			Buffer.Add(PsDataMsgPack::Int8);
+			WriteBigEndian(static_cast<uint64>(Value), 1);
+		}
+		else if (Value >= MIN_int16)
+		{
+			Buffer.Add(PsDataMsgPack::Int16);
+			WriteBigEndian(static_cast<uint64>(Value), 2);
+		}
+		else if (Value >= MIN_int32)
+		{
+			Buffer.Add(PsDataMsgPack::Int32);
+			WriteBigEndian(static_cast<uint64>(Value), 4);
+		}
+		else
+		{
+			Buffer.Add(PsDataMsgPack::Int64);
+			WriteBigEndian(static_cast<uint64>(Value), 8);
+		}
+	}
+}
+
+void FPsDataMsgPackSerializer::WriteString(const FString& Value)
+{
+	FTCHARToUTF8 Converter(*Value);
+	const uint32 Len = static_cast<uint32>(Converter.Length());
+	if (Len < 32)
+	{
+		Buffer.Add(PsDataMsgPack::FixStr | static_cast<uint8>(Len));
+	}
+	else if (Len <= MAX_uint8)
+	{
+		Buffer.Add(PsDataMsgPack::Str8);
+		WriteBigEndian(Len, 1);
+	}
+	else if (Len <= MAX_uint16)
+	{
+		Buffer.Add(PsDataMsgPack::Str16);
+		WriteBigEndian(Len, 2);
+	}
+	else
+	{
+		Buffer.Add(PsDataMsgPack::Str32);
+		WriteBigEndian(Len, 4);
+	}
+
+	Buffer.Append(reinterpret_cast<const uint8*>(Converter.Get()), Len);
+}
+
+void FPsDataMsgPackSerializer::WriteKey(const FString& Key)
+{
+	check(Stack.Num() > 0 && Stack.Last().bMap);
+	++Stack.Last().Count;
+	WriteString(Key);
+}
+
+void FPsDataMsgPackSerializer::WriteArray()
+{
+	WriteContainer(false);
+}
+
+void FPsDataMsgPackSerializer::WriteObject()
+{
+	WriteContainer(true);
+}
+
+void FPsDataMsgPackSerializer::WriteValue(int32 Value)
+{
+	AddElement();
+	WriteInteger(Value);
+}
+
+void FPsDataMsgPackSerializer::WriteValue(int64 Value)
+{
+	AddElement();
+	WriteInteger(Value);
+}
+
+void FPsDataMsgPackSerializer::WriteValue(uint8 Value)
+{
+	AddElement();
+	WriteInteger(Value);
+}
+
+void FPsDataMsgPackSerializer::WriteValue(float Value)
+{
+	AddElement();
+
+	uint32 Bits = 0;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	Buffer.Add(PsDataMsgPack::Float32);
+	WriteBigEndian(Bits, 4);
+}
+
+void FPsDataMsgPackSerializer::WriteValue(bool Value)
+{
+	AddElement();
+	Buffer.Add(Value ? PsDataMsgPack::True : PsDataMsgPack::False);
+}
+
+void FPsDataMsgPackSerializer::WriteValue(const FString& Value)
+{
+	AddElement();
+	WriteString(Value);
+}
+
+void FPsDataMsgPackSerializer::WriteValue(const FName& Value)
+{
+	AddElement();
+	WriteString(Value.ToString());
+}
+
+void FPsDataMsgPackSerializer::WriteValue(const UPsData* Value)
+{
+	if (Value == nullptr)
+	{
+		AddElement();
+		Buffer.Add(PsDataMsgPack::Nil);
+	}
+	else
+	{
+		WriteObject();
+		FDataReflectionTools::FPsDataFriend::Serialize(Value, this);
+		PopObject();
+	}
+}
+
+void FPsDataMsgPackSerializer::PopKey(const FString& Key)
+{
+}
+
+void FPsDataMsgPackSerializer::PopArray()
+{
+	PopContainer(false);
+}
+
+void FPsDataMsgPackSerializer::PopObject()
+{
+	PopContainer(true);
+}
+
+/***********************************
+ * FPsDataMsgPackDeserializer
+ ***********************************/
+
+FPsDataMsgPackDeserializer::FPsDataMsgPackDeserializer(TArray<uint8> InBuffer)
+	: FPsDataDeserializer()
+	, Buffer(MoveTemp(InBuffer))
+	, Position(0)
+{
+}
+
+bool FPsDataMsgPackDeserializer::CanRead(int32 NumBytes) const
+{
+	return NumBytes >= 0 && NumBytes <= Buffer.Num() - Position;
+}
+
+uint64 FPsDataMsgPackDeserializer::ReadBigEndian(int32 NumBytes)
+{
+	if (!CanRead(NumBytes))
+	{
+		Position = Buffer.Num();
+		return 0;
+	}
+
+	uint64 Value = 0;
+	for (int32 i = 0; i < NumBytes; ++i)
+	{
+		Value = (Value << 8) | Buffer[Position++];
+	}
+	return Value;
+}
+
+bool FPsDataMsgPackDeserializer::ReadContainer(bool bMap)
+{
+	if (!CanRead(1))
+	{
+		return false;
+	}
+
+	const uint8 Type = Buffer[Position];
+	const uint8 Fix = bMap ? PsDataMsgPack::FixMap : PsDataMsgPack::FixArray;
+	const uint8 Type16 = bMap ? PsDataMsgPack::Map16 : PsDataMsgPack::Array16;
+	const uint8 Type32 = bMap ? PsDataMsgPack::Map32 : PsDataMsgPack::Array32;
+
+	int32 Count = 0;
+	if ((Type & 0xf0) == Fix)
+	{
+		Count = Type & 0x0f;
+		Position += 1;
+	}
+	else if (Type == Type16 && CanRead(3))
+	{
+		Position += 1;
+		Count = static_cast<int32>(ReadBigEndian(2));
+	}
+	else if (Type == Type32 && CanRead(5))
+	{
+		Position += 1;
+		const uint32 Count32 = static_cast<uint32>(ReadBigEndian(4));
+		if (Count32 > static_cast<uint32>(Buffer.Num() - Position))
+		{
+			Position -= 5;
+			return false;
+		}
+		Count = static_cast<int32>(Count32);
+	}
+	else
+	{
+		return false;
+	}
+
+	Stack.Push(Count);
+	return true;
+}
+
+bool FPsDataMsgPackDeserializer::ReadInteger(int64& OutValue)
+{
+	if (!CanRead(1))
+	{
+		return false;
+	}
+
+	const uint8 Type = Buffer[Position];
+	if (Type < 0x80)
+	{
+		OutValue = Type;
+		Position += 1;
+		return true;
+	}
+
+	if (Type >= PsDataMsgPack::NegativeFixInt)
+	{
+		OutValue = static_cast<int8>(Type);
+		Position += 1;
+		return true;
+	}
+
+	int32 NumBytes = 0;
+	bool bSigned = false;
+	switch (Type)
+	{
+	case PsDataMsgPack::Uint8:
+		NumBytes = 1;
+		break;
+	case PsDataMsgPack::Uint16:
+		NumBytes = 2;
+		break;
+	case PsDataMsgPack::Uint32:
+		NumBytes = 4;
+		break;
+	case PsDataMsgPack::Uint64:
+		NumBytes = 8;
+		break;
+	case PsDataMsgPack::Int8:
+		NumBytes = 1;
+		bSigned = true;
+		break;
+	case PsDataMsgPack::Int16:
+		NumBytes = 2;
+		bSigned = true;
+		break;
+	case PsDataMsgPack::Int32:
+		NumBytes = 4;
+		bSigned = true;
+		break;
+	case PsDataMsgPack::Int64:
+		NumBytes = 8;
+		bSigned = true;
+		break;
+	default:
+		return false;
+	}
+
+	if (!CanRead(NumBytes + 1))
+	{
+		return false;
+	}
+
+	Position += 1;
+	const uint64 Value = ReadBigEndian(NumBytes);
+	if (bSigned && NumBytes < 8)
+	{
+		const uint32 Shift = 64 - NumBytes * 8;
+		OutValue = static_cast<int64>(Value << Shift) >> Shift;
+	}
+	else
+	{
+		OutValue = static_cast<int64>(Value);
+	}
+	return true;
+}
+
+bool FPsDataMsgPackDeserializer::ReadString(FString& OutValue)
+{
+	if (!CanRead(1))
+	{
+		return false;
+	}
+
+	const int32 StartPosition = Position;
+	const uint8 Type = Buffer[Position];
+	int32 Len = 0;
+	if ((Type & 0xe0) == PsDataMsgPack::FixStr)
+	{
+		Len = Type & 0x1f;
+		Position += 1;
+	}
+	else if (Type == PsDataMsgPack::Str8 && CanRead(2))
+	{
+		Position += 1;
+		Len = static_cast<int32>(ReadBigEndian(1));
+	}
+	else if (Type == PsDataMsgPack::Str16 && CanRead(3))
+	{
+		Position += 1;
+		Len = static_cast<int32>(ReadBigEndian(2));
+	}
+	else if (Type == PsDataMsgPack::Str32 && CanRead(5))
+	{
+		Position += 1;
+		const uint32 Len32 = static_cast<uint32>(ReadBigEndian(4));
+		Len = Len32 > static_cast<uint32>(MAX_int32) ? -1 : static_cast<int32>(Len32);
+	}
+	else
+	{
+		return false;
+	}
+
+	if (!CanRead(Len))
+	{
+		Position = StartPosition;
+		return false;
+	}
+
+	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + Position), Len);
+	OutValue = FString(Converter.Length(), Converter.Get());
+	Position += Len;
+	return true;
+}
+
+bool FPsDataMsgPackDeserializer::Skip(uint64 NumBytes)
+{
+	if (NumBytes > static_cast<uint64>(Buffer.Num() - Position))
+	{
+		Position = Buffer.Num();
+		return false;
+	}
+
+	Position += static_cast<int32>(NumBytes);
+	return true;
+}
+
+void FPsDataMsgPackDeserializer::SkipValue()
+{
+	// Every element takes at least one byte, so counts above the rest of buffer are malformed
+	int64 Pending = 1;
+	while (Pending > 0 && CanRead(1))
+	{
+		--Pending;
+
+		const uint8 Type = Buffer[Position++];
+		if (Type < 0x80 || Type >= PsDataMsgPack::NegativeFixInt || Type == PsDataMsgPack::Nil || Type == PsDataMsgPack::False || Type == PsDataMsgPack::True)
+		{
+			continue;
+		}
+
+		if ((Type & 0xf0) == PsDataMsgPack::FixMap)
+		{
+			Pending += (Type & 0x0f) * 2;
+			continue;
+		}
+
+		if ((Type & 0xf0) == PsDataMsgPack::FixArray)
+		{
+			Pending += Type & 0x0f;
+			continue;
+		}
+
+		if ((Type & 0xe0) == PsDataMsgPack::FixStr)
+		{
+			if (!Skip(Type & 0x1f))
+			{
+				return;
+			}
+			continue;
+		}
+
+		if (Type >= PsDataMsgPack::FixExt1 && Type <= PsDataMsgPack::FixExt16)
+		{
+			if (!Skip(1 + (1 << (Type - PsDataMsgPack::FixExt1))))
+			{
+				return;
+			}
+			continue;
+		}
+
+		uint64 NumBytes = 0;
+		int32 LenBytes = 0;
+		int32 ExtraBytes = 0;
+		int32 NumPerElement = 0;
+		switch (Type)
+		{
+		case PsDataMsgPack::Uint8:
+		case PsDataMsgPack::Int8:
+			NumBytes = 1;
+			break;
+		case PsDataMsgPack::Uint16:
+		case PsDataMsgPack::Int16:
+			NumBytes = 2;
+			break;
+		case PsDataMsgPack::Uint32:
+		case PsDataMsgPack::Int32:
+		case PsDataMsgPack::Float32:
+			NumBytes = 4;
+			break;
+		case PsDataMsgPack::Uint64:
+		case PsDataMsgPack::Int64:
+		case PsDataMsgPack::Float64:
+			NumBytes = 8;
+			break;
+		case PsDataMsgPack::Str8:
+		case PsDataMsgPack::Bin8:
+			LenBytes = 1;
+			break;
+		case PsDataMsgPack::Str16:
+		case PsDataMsgPack::Bin16:
+			LenBytes = 2;
+			break;
+		case PsDataMsgPack::Str32:
+		case PsDataMsgPack::Bin32:
+			LenBytes = 4;
+			break;
+		case PsDataMsgPack::Ext8:
+			LenBytes = 1;
+			ExtraBytes = 1;
+			break;
+		case PsDataMsgPack::Ext16:
+			LenBytes = 2;
+			ExtraBytes = 1;
+			break;
+		case PsDataMsgPack::Ext32:
+			LenBytes = 4;
+			ExtraBytes = 1;
+			break;
+		case PsDataMsgPack::Array16:
+			LenBytes = 2;
+			NumPerElement = 1;
+			break;
+		case PsDataMsgPack::Array32:
+			LenBytes = 4;
+			NumPerElement = 1;
+			break;
+		case PsDataMsgPack::Map16:
+			LenBytes = 2;
+			NumPerElement = 2;
+			break;
+		case PsDataMsgPack::Map32:
+			LenBytes = 4;
+			NumPerElement = 2;
+			break;
+		default:
+			UE_LOG(LogData, Warning, TEXT("Unknown msgpack type 0x%02x"), Type);
+			Position = Buffer.Num();
+			return;
+		}
+
+		if (LenBytes > 0)
+		{
+			if (!CanRead(LenBytes))
+			{
+				Position = Buffer.Num();
+				return;
+			}
+			NumBytes = ReadBigEndian(LenBytes) + ExtraBytes;
+		}
+
+		if (NumPerElement > 0)
+		{
+			if (NumBytes * NumPerElement > static_cast<uint64>(Buffer.Num() - Position))
+			{
+				Position = Buffer.Num();
+				return;
+			}
+			Pending += static_cast<int64>(NumBytes * NumPerElement);
+		}
+		else if (!Skip(NumBytes))
+		{
+			return;
+		}
+	}
+}
+
+bool FPsDataMsgPackDeserializer::ReadKey(FString& OutKey)
+{
+	if (Stack.Num() == 0 || Stack.Last() == 0)
+	{
+		return false;
+	}
+
+	if (!ReadString(OutKey))
+	{
+		return false;
+	}
+
+	--Stack.Last();
+	ValuePositions.Push(Position);
+	return true;
+}
+
+bool FPsDataMsgPackDeserializer::ReadIndex()
+{
+	if (Stack.Num() == 0 || Stack.Last() == 0)
+	{
+		return false;
+	}
+
+	--Stack.Last();
+	return true;
+}
+
+bool FPsDataMsgPackDeserializer::ReadArray()
+{
+	return ReadContainer(false);
+}
+
+bool FPsDataMsgPackDeserializer::ReadObject()
+{
+	return ReadContainer(true);
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(int32& OutValue)
+{
+	const int32 StartPosition = Position;
+	int64 Value = 0;
+	if (ReadInteger(Value) && Value >= MIN_int32 && Value <= MAX_int32)
+	{
+		OutValue = static_cast<int32>(Value);
+		return true;
+	}
+
+	Position = StartPosition;
+	return false;
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(int64& OutValue)
+{
+	return ReadInteger(OutValue);
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(uint8& OutValue)
+{
+	const int32 StartPosition = Position;
+	int64 Value = 0;
+	if (ReadInteger(Value) && Value >= 0 && Value <= MAX_uint8)
+	{
+		OutValue = static_cast<uint8>(Value);
+		return true;
+	}
+
+	Position = StartPosition;
+	return false;
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(float& OutValue)
+{
+	if (CanRead(5) && Buffer[Position] == PsDataMsgPack::Float32)
+	{
+		Position += 1;
+		const uint32 Bits = static_cast<uint32>(ReadBigEndian(4));
+		FMemory::Memcpy(&OutValue, &Bits, sizeof(Bits));
+		return true;
+	}
+
+	if (CanRead(9) && Buffer[Position] == PsDataMsgPack::Float64)
+	{
+		Position += 1;
+		const uint64 Bits = ReadBigEndian(8);
+		double Value = 0.0;
+		FMemory::Memcpy(&Value, &Bits, sizeof(Bits));
+		OutValue = static_cast<float>(Value);
+		return true;
+	}
+
+	int64 Value = 0;
+	if (ReadInteger(Value))
+	{
+		OutValue = static_cast<float>(Value);
+		return true;
+	}
+
+	return false;
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(bool& OutValue)
+{
+	if (CanRead(1) && (Buffer[Position] == PsDataMsgPack::True || Buffer[Position] == PsDataMsgPack::False))
+	{
+		OutValue = Buffer[Position] == PsDataMsgPack::True;
+		Position += 1;
+		return true;
+	}
+	return false;
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(FString& OutValue)
+{
+	return ReadString(OutValue);
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(FName& OutValue)
+{
+	FString String;
+	if (ReadString(String))
+	{
+		OutValue = *String;
+		return true;
+	}
+	return false;
+}
+
+bool FPsDataMsgPackDeserializer::ReadValue(UPsData*& OutValue, FPsDataAllocator Allocator)
+{
+	if (CanRead(1) && Buffer[Position] == PsDataMsgPack::Nil)
+	{
+		Position += 1;
+		OutValue = nullptr;
+		return true;
+	}
+	else if (ReadObject())
+	{
+		if (OutValue == nullptr)
+		{
+			OutValue = Allocator();
+		}
+
+		FDataReflectionTools::FPsDataFriend::Deserialize(OutValue, this);
+
+		PopObject();
+
+		return true;
+	}
+	return false;
+}
+
+void FPsDataMsgPackDeserializer::PopKey(const FString& Key)
+{
+	check(ValuePositions.Num() > 0);
+	if (ValuePositions.Pop(false) == Position)
+	{
+		SkipValue();
+	}
+}
+
+void FPsDataMsgPackDeserializer::PopIndex()
+{
+}
+
+void FPsDataMsgPackDeserializer::PopArray()
+{
+	check(Stack.Num() > 0);
+	for (int32 i = Stack.Last(); i > 0; --i)
+	{
+		SkipValue();
+	}
+	Stack.Pop(false);
+}
+
+void FPsDataMsgPackDeserializer::PopObject()
+{
+	check(Stack.Num() > 0);
+	for (int32 i = Stack.Last() * 2; i > 0; --i)
+	{
+		SkipValue();
+	}
+	Stack.Pop(false);
+}
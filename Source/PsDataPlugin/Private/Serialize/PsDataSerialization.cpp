@@ -39,12 +39,45 @@ UPsData* FPsDataAllocator::operator()() const
 	}
 }
 
+/***********************************
+ * FPsDataClassPlan
+ ***********************************/
+
+FPsDataClassPlanEntry::FPsDataClassPlanEntry()
+	: Index(INDEX_NONE)
+	, TypeHash(0)
+	, Field(nullptr)
+{
+}
+
+int32 FPsDataClassPlan::Find(const FString& Alias, int32 Hint) const
+{
+	if (Entries.IsValidIndex(Hint) && Entries[Hint].Alias == Alias)
+	{
+		return Hint;
+	}
+
+	const int32* Find = EntryIndices.Find(Alias);
+	return Find ? *Find : INDEX_NONE;
+}
+
 /***********************************
  * FPsDataSerializer
  ***********************************/
 
 FPsDataSerializer::FPsDataSerializer()
+	: Type(EPsDataSerializerType::Custom)
+{
+}
+
+FPsDataSerializer::FPsDataSerializer(EPsDataSerializerType InType)
+	: Type(InType)
+{
+}
+
+void FPsDataSerializer::WriteFieldKey(const FPsDataClassPlanEntry& Entry)
 {
+	WriteKey(Entry.Alias);
 }
 
 /***********************************
@@ -0,0 +1,277 @@
+// Copyright 2015-2020 Mail.Ru Group. All Rights Reserved.
+
+#include "Serialize/PsDataSnapshotSerialization.h"
+
+#include "PsData.h"
+#include "PsDataCore.h"
+
+namespace PsDataSnapshot
+{
+static constexpr uint32 Magic = 0x50534453;
+static constexpr uint32 Version = 1;
+} // namespace PsDataSnapshot
+
+/***********************************
+ * FPsDataSnapshotSerializer
+ ***********************************/
+
+FPsDataSnapshotSerializer::FPsDataSnapshotSerializer(TSharedRef<FPsDataOutputStream> InOutputStream)
+	: FPsDataBinarySerializer(MakeShared<FPsDataBufferOutputStream>())
+	, TargetStream(InOutputStream)
+	, BodyStream(StaticCastSharedRef<FPsDataBufferOutputStream>(OutputStream))
+{
+}
+
+uint32 FPsDataSnapshotSerializer::GetClassIndex(const UClass* Class)
+{
+	if (const uint32* Find = ClassIndices.Find(Class))
+	{
+		return *Find;
+	}
+
+	const uint32 Index = static_cast<uint32>(Classes.Add(Class));
+	ClassIndices.Add(Class, Index);
+	return Index;
+}
+
+void FPsDataSnapshotSerializer::Finish()
+{
+	TargetStream->WriteUint32(PsDataSnapshot::Magic);
+	TargetStream->WriteUint32(PsDataSnapshot::Version);
+	TargetStream->WriteUint32(static_cast<uint32>(Classes.Num()));
+	for (const UClass* Class : Classes)
+	{
+		const FPsDataClassPlan* Plan = FDataReflection::GetClassPlan(Class);
+		check(Plan);
+
+		TargetStream->WriteString(Class->GetPathName());
+		TargetStream->WriteUint32(static_cast<uint32>(Plan->Entries.Num()));
+		for (const FPsDataClassPlanEntry& Entry : Plan->Entries)
+		{
+			TargetStream->WriteString(Entry.Alias);
+			TargetStream->WriteUint32(Entry.TypeHash);
+		}
+	}
+
+	TargetStream->WriteBuffer(BodyStream->GetBuffer());
+	BodyStream->Reset();
+}
+
+void FPsDataSnapshotSerializer::WriteValue(const UPsData* Value)
+{
+	const FPsDataClassPlan* Plan = Value ? FDataReflection::GetClassPlan(Value->GetClass()) : nullptr;
+	if (Plan == nullptr)
+	{
+		FPsDataBinarySerializer::WriteValue(Value);
+		return;
+	}
+
+	OutputStream->WriteUint8(static_cast<uint8>(EBinaryTokens::SchemaObjectBegin));
+	OutputStream->WriteUint32(GetClassIndex(Value->GetClass()));
+
+	const auto& Properties = FDataReflectionTools::FPsDataFriend::GetProperties(const_cast<UPsData*>(Value));
+	for (const FPsDataClassPlanEntry& Entry : Plan->Entries)
+	{
+		Properties[Entry.Index]->Serialize(Value, this);
+	}
+
+	PopObject();
+}
+
+/***********************************
+ * FPsDataSnapshotDeserializer
+ ***********************************/
+
+FPsDataSnapshotDeserializer::FPsDataSnapshotDeserializer(TSharedRef<FPsDataInputStream> InInputStream)
+	: FPsDataBinaryDeserializer(InInputStream)
+	, bValid(false)
+{
+	if (!InputStream->HasData() || InputStream->ReadUint32() != PsDataSnapshot::Magic)
+	{
+		UE_LOG(LogData, Error, TEXT("Snapshot header not found"));
+		return;
+	}
+
+	const uint32 Version = InputStream->ReadUint32();
+	if (Version != PsDataSnapshot::Version)
+	{
+		UE_LOG(LogData, Error, TEXT("Unsupported snapshot version %d"), Version);
+		return;
+	}
+
+	const uint32 NumClasses = InputStream->ReadUint32();
+	Schema.SetNum(NumClasses);
+	for (FClassSchema& ClassSchema : Schema)
+	{
+		ClassSchema.ClassPath = InputStream->ReadString();
+		ClassSchema.RemapClass = nullptr;
+
+		const uint32 NumFields = InputStream->ReadUint32();
+		ClassSchema.Aliases.Reserve(NumFields);
+		ClassSchema.TypeHashes.Reserve(NumFields);
+		for (uint32 i = 0; i < NumFields; ++i)
+		{
+			ClassSchema.Aliases.Add(InputStream->ReadString());
+			ClassSchema.TypeHashes.Add(InputStream->ReadUint32());
+		}
+	}
+
+	bValid = true;
+}
+
+bool FPsDataSnapshotDeserializer::IsValid() const
+{
+	return bValid;
+}
+
+const TArray<int32>& FPsDataSnapshotDeserializer::GetRemap(FClassSchema& ClassSchema, const UClass* Class)
+{
+	if (ClassSchema.RemapClass == Class)
+	{
+		return ClassSchema.Remap;
+	}
+
+	ClassSchema.RemapClass = Class;
+	ClassSchema.Remap.Reset(ClassSchema.Aliases.Num());
+
+	const FPsDataClassPlan* Plan = FDataReflection::GetClassPlan(Class);
+	bool bMatches = Plan != nullptr && Plan->Entries.Num() == ClassSchema.Aliases.Num();
+	for (int32 i = 0; i < ClassSchema.Aliases.Num(); ++i)
+	{
+		// same schema resolves every field at the same position
+		const int32 EntryIndex = Plan ? Plan->Find(ClassSchema.Aliases[i], i) : INDEX_NONE;
+		if (EntryIndex != INDEX_NONE && Plan->Entries[EntryIndex].TypeHash == ClassSchema.TypeHashes[i])
+		{
+			ClassSchema.Remap.Add(Plan->Entries[EntryIndex].Index);
+			bMatches &= (EntryIndex == i);
+		}
+		else
+		{
+			UE_LOG(LogData, Warning, TEXT("Snapshot property \"%s\" of \"%s\" is skipped for \"%s\""), *ClassSchema.Aliases[i], *ClassSchema.ClassPath, *Class->GetName());
+			ClassSchema.Remap.Add(INDEX_NONE);
+			bMatches = false;
+		}
+	}
+
+	if (!bMatches)
+	{
+		UE_LOG(LogData, Verbose, TEXT("Snapshot schema of \"%s\" differs from \"%s\", fields are remapped"), *ClassSchema.ClassPath, *Class->GetName());
+	}
+
+	return ClassSchema.Remap;
+}
+
+void FPsDataSnapshotDeserializer::SkipValue()
+{
+	if (!InputStream->HasData())
+	{
+		return;
+	}
+
+	switch (static_cast<EBinaryTokens>(InputStream->ReadUint8()))
+	{
+	case EBinaryTokens::Value_int32:
+		InputStream->ReadInt32();
+		break;
+	case EBinaryTokens::Value_int64:
+		InputStream->ReadInt64();
+		break;
+	case EBinaryTokens::Value_uint8:
+		InputStream->ReadUint8();
+		break;
+	case EBinaryTokens::Value_float:
+		InputStream->ReadFloat();
+		break;
+	case EBinaryTokens::Value_bool:
+		InputStream->ReadBool();
+		break;
+	case EBinaryTokens::Value_FString:
+	case EBinaryTokens::Value_FName:
+		InputStream->ReadString();
+		break;
+	case EBinaryTokens::Value_null:
+		break;
+	case EBinaryTokens::ArrayBegin:
+		while (InputStream->HasData() && !ReadToken(EBinaryTokens::ArrayEnd))
+		{
+			SkipValue();
+		}
+		break;
+	case EBinaryTokens::ObjectBegin:
+		while (InputStream->HasData() && !ReadToken(EBinaryTokens::ObjectEnd))
+		{
+			if (!ReadToken(EBinaryTokens::Key))
+			{
+				UE_LOG(LogData, Error, TEXT("Broken snapshot object"));
+				return;
+			}
+			InputStream->ReadString();
+			SkipValue();
+		}
+		break;
+	case EBinaryTokens::SchemaObjectBegin:
+	{
+		const uint32 ClassIndex = InputStream->ReadUint32();
+		if (!Schema.IsValidIndex(ClassIndex))
+		{
+			UE_LOG(LogData, Error, TEXT("Broken snapshot class index %d"), ClassIndex);
+			return;
+		}
+
+		for (int32 i = 0; i < Schema[ClassIndex].Aliases.Num(); ++i)
+		{
+			SkipValue();
+		}
+		PopObject();
+		break;
+	}
+	default:
+		UE_LOG(LogData, Error, TEXT("Broken snapshot value"));
+		break;
+	}
+}
+
+bool FPsDataSnapshotDeserializer::ReadValue(UPsData*& OutValue, FPsDataAllocator Allocator)
+{
+	if (!bValid)
+	{
+		return false;
+	}
+
+	if (ReadToken(EBinaryTokens::SchemaObjectBegin))
+	{
+		const uint32 ClassIndex = InputStream->ReadUint32();
+		if (!Schema.IsValidIndex(ClassIndex))
+		{
+			UE_LOG(LogData, Error, TEXT("Broken snapshot class index %d"), ClassIndex);
+			return false;
+		}
+
+		if (OutValue == nullptr)
+		{
+			OutValue = Allocator();
+		}
+
+		const TArray<int32>& Remap = GetRemap(Schema[ClassIndex], OutValue->GetClass());
+		auto& Properties = FDataReflectionTools::FPsDataFriend::GetProperties(OutValue);
+		for (const int32 PropertyIndex : Remap)
+		{
+			if (PropertyIndex != INDEX_NONE)
+			{
+				Properties[PropertyIndex]->Deserialize(OutValue, this);
+			}
+			else
+			{
+				SkipValue();
+			}
+		}
+
+		FDataReflectionTools::FPsDataFriend::PostDeserialize(OutValue);
+
+		PopObject();
+
+		return true;
+	}
+
+	return FPsDataBinaryDeserializer::ReadValue(OutValue, Allocator);
+}
@@ -116,6 +116,11 @@ bool FPsDataBufferInputStream::HasData()
 	return Index < Buffer.Num();
 }
 
+int32 FPsDataBufferInputStream::Remaining()
+{
+	return Buffer.Num() - Index;
+}
+
 void FPsDataBufferInputStream::ShiftBack()
 {
 	check(PrevIndex >= 0);
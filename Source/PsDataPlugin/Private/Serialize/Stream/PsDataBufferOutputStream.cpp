@@ -97,3 +97,8 @@ void FPsDataBufferOutputStream::WriteString(const FString& Value)
 		}
 	}
 }
+
+void FPsDataBufferOutputStream::WriteBuffer(const TArray<uint8>& Value)
+{
+	Buffer.Append(Value);
+}
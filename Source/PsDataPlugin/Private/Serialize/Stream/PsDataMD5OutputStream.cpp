@@ -122,3 +122,8 @@ void FPsDataMD5OutputStream::WriteString(const FString& Value)
 	Write(Md5Gen, OutputSteram.GetBuffer());
 	OutputSteram.Reset();
 }
+
+void FPsDataMD5OutputStream::WriteBuffer(const TArray<uint8>& Value)
+{
+	Write(Md5Gen, Value);
+}